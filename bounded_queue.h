@@ -0,0 +1,91 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// Blocking FIFO with a fixed capacity, used to connect pipeline stages.
+// Producers block while the queue is full, consumers block while it is empty.
+// Once close() is called, pop() drains the remaining items and then returns false.
+template <typename T>
+class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (items.size() >= capacity && !closed) pushWaits++;
+            notFull.wait(lock, [this] { return items.size() < capacity || closed; });
+            if (closed) return false;
+
+            items.push_back(std::move(item));
+            pushes++;
+            depthSum += items.size();
+            if (items.size() > maxDepth) maxDepth = items.size();
+            notEmpty.notify_one();
+            return true;
+        }
+
+        bool pop(T &item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (items.empty() && !closed) popWaits++;
+            notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+            if (items.empty()) return false;
+
+            item = std::move(items.front());
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            notEmpty.notify_all();
+            notFull.notify_all();
+        }
+
+        size_t getCapacity() const { return capacity; }
+
+        size_t getMaxDepth() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return maxDepth;
+        }
+
+        // Mean queue depth observed right after each push.
+        double getAverageDepth() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return pushes == 0 ? 0.0 : static_cast<double>(depthSum) / pushes;
+        }
+
+        // Number of pushes that had to wait for space (downstream stage is the bottleneck).
+        long long getPushWaits() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return pushWaits;
+        }
+
+        // Number of pops that had to wait for data (upstream stage is the bottleneck).
+        long long getPopWaits() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return popWaits;
+        }
+
+    private:
+        const size_t capacity;
+        std::deque<T> items;
+        bool closed = false;
+
+        mutable std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+
+        long long pushes = 0;
+        long long depthSum = 0;
+        size_t maxDepth = 0;
+        long long pushWaits = 0;
+        long long popWaits = 0;
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,514 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "distributed_sort.h"
+#include "bounded_queue.h"
+#include "sort.h"
+
+namespace {
+    using Clock = std::chrono::high_resolution_clock;
+
+    double elapsedMs(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    }
+
+    bool sendAll(int fd, const void *data, size_t length) {
+        const char *p = static_cast<const char *>(data);
+        while (length > 0) {
+            ssize_t sent = send(fd, p, length, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent <= 0) return false;
+            p += sent;
+            length -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    bool recvAll(int fd, void *data, size_t length) {
+        char *p = static_cast<char *>(data);
+        while (length > 0) {
+            ssize_t received = recv(fd, p, length, 0);
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) return false;
+            p += received;
+            length -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    // Control socket protocol between a worker and the coordinator: the worker sends LOADED_TOKEN
+    // or LOAD_FAILED_TOKEN after loading its shard, the coordinator answers GO_TOKEN once every
+    // worker has loaded, and the worker finally sends its WorkerReport.
+    const char LOADED_TOKEN = 'L';
+    const char LOAD_FAILED_TOKEN = 'F';
+    const char GO_TOKEN = 'G';
+
+    // Loads a shard in StringGenerator file format: a key count line followed by that many keys.
+    // Unlike StringGenerator::loadArrayFromFile it fails on an unreadable file, a missing or
+    // malformed count line and a shard holding fewer keys than its count.
+    bool loadShard(const std::string &filename, std::vector<std::string> &keys, std::string &error) {
+        std::ifstream inFile(filename, std::ios::binary);
+        if (!inFile.is_open()) {
+            error = "cannot open shard";
+            return false;
+        }
+        std::string line;
+        if (!std::getline(inFile, line)) {
+            error = "cannot read the key count line";
+            return false;
+        }
+        char *end = nullptr;
+        errno = 0;
+        long long count = std::strtoll(line.c_str(), &end, 10);
+        if (line.empty() || *end != '\0' || errno == ERANGE || count < 0) {
+            error = "bad key count line";
+            return false;
+        }
+        keys.clear();
+        keys.reserve(static_cast<size_t>(count));
+        for (long long i = 0; i < count; ++i) {
+            if (!std::getline(inFile, line)) {
+                error = "holds " + std::to_string(i) + " keys, the count line says " + std::to_string(count);
+                return false;
+            }
+            keys.push_back(std::move(line));
+        }
+        return true;
+    }
+
+    // Writes keys in the same format, returning false if the file cannot be written completely.
+    bool writePart(const std::string &filename, const std::vector<std::string> &keys) {
+        std::ofstream outFile(filename, std::ios::binary);
+        if (!outFile.is_open()) return false;
+        outFile << keys.size() << '\n';
+        for (const auto &key : keys) {
+            outFile << key << '\n';
+        }
+        outFile.close();
+        return !outFile.fail();
+    }
+
+    // Removes part_<i>.txt files with i >= workers, left over from a run with more workers.
+    void removeStaleParts(const std::string &outputDir, int workers) {
+        std::error_code error;
+        std::vector<std::filesystem::path> stale;
+        for (const auto &entry : std::filesystem::directory_iterator(outputDir, error)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() <= 9 || name.compare(0, 5, "part_") != 0 || name.compare(name.size() - 4, 4, ".txt") != 0) continue;
+            std::string index = name.substr(5, name.size() - 9);
+            if (!std::all_of(index.begin(), index.end(), [](char c) { return c >= '0' && c <= '9'; })) continue;
+            if (index.size() > 9 || std::stoi(index) >= workers) stale.push_back(entry.path());
+        }
+        for (const auto &path : stale) std::filesystem::remove(path, error);
+    }
+
+    // Every message is a header followed by keyCount keys, each as a uint32 length and its bytes.
+    // A header with no keys marks the end of the sender's stream for the current round.
+    struct FrameHeader {
+        uint32_t keyCount;
+        uint32_t payloadBytes;
+    };
+
+    struct OutgoingFrame {
+        int dest;
+        uint32_t keyCount;
+        std::string payload;
+    };
+
+    // One all-to-all round between workers. A sender thread writes batches while a receiver
+    // thread drains every peer socket, so two workers sending to each other cannot deadlock.
+    class PeerExchange {
+        public:
+            PeerExchange(const std::vector<int> &peerFds, int self, size_t batchBytes)
+                : peerFds(peerFds), self(self), batchBytes(batchBytes),
+                  buffers(peerFds.size()), bufferedKeys(peerFds.size(), 0), outgoing(8) {
+                sender = std::thread([this] { sendLoop(); });
+                receiver = std::thread([this] { receiveLoop(); });
+            }
+
+            void send(int dest, const std::string &key) {
+                uint32_t length = static_cast<uint32_t>(key.size());
+                buffers[dest].append(reinterpret_cast<const char *>(&length), sizeof(length));
+                buffers[dest] += key;
+                bufferedKeys[dest]++;
+                keysSent++;
+                if (buffers[dest].size() >= batchBytes) flush(dest);
+            }
+
+            // Flushes the remaining batches, signals the end of the round and waits for all peers.
+            bool finish(std::vector<std::string> &received) {
+                for (size_t dest = 0; dest < peerFds.size(); ++dest) {
+                    if (static_cast<int>(dest) == self) continue;
+                    flush(static_cast<int>(dest));
+                    outgoing.push({static_cast<int>(dest), 0, std::string()});
+                }
+                outgoing.close();
+                sender.join();
+                receiver.join();
+                received = std::move(keys);
+                return ok;
+            }
+
+            long long getKeysSent() const { return keysSent; }
+            long long getBytesSent() const { return bytesSent; }
+
+        private:
+            const std::vector<int> &peerFds;
+            int self;
+            size_t batchBytes;
+
+            std::vector<std::string> buffers;
+            std::vector<uint32_t> bufferedKeys;
+            BoundedQueue<OutgoingFrame> outgoing;
+            std::vector<std::string> keys;
+            long long keysSent = 0;
+            long long bytesSent = 0;
+            std::atomic<bool> ok{true};
+
+            std::thread sender;
+            std::thread receiver;
+
+            void flush(int dest) {
+                if (bufferedKeys[dest] == 0) return;
+                outgoing.push({dest, bufferedKeys[dest], std::move(buffers[dest])});
+                buffers[dest] = std::string();
+                bufferedKeys[dest] = 0;
+            }
+
+            void sendLoop() {
+                OutgoingFrame frame;
+                while (outgoing.pop(frame)) {
+                    FrameHeader header{frame.keyCount, static_cast<uint32_t>(frame.payload.size())};
+                    if (!sendAll(peerFds[frame.dest], &header, sizeof(header)) ||
+                        !sendAll(peerFds[frame.dest], frame.payload.data(), frame.payload.size())) {
+                        std::cerr << "Worker " << self << ": failed to send to worker " << frame.dest << std::endl;
+                        ok = false;
+                    }
+                    bytesSent += static_cast<long long>(sizeof(header) + frame.payload.size());
+                }
+            }
+
+            void receiveLoop() {
+                std::vector<pollfd> open;
+                std::vector<int> openPeers;
+                for (size_t peer = 0; peer < peerFds.size(); ++peer) {
+                    if (static_cast<int>(peer) == self) continue;
+                    open.push_back({peerFds[peer], POLLIN, 0});
+                    openPeers.push_back(static_cast<int>(peer));
+                }
+
+                std::string payload;
+                while (!open.empty()) {
+                    if (poll(open.data(), open.size(), -1) < 0) {
+                        if (errno == EINTR) continue;
+                        ok = false;
+                        return;
+                    }
+                    for (size_t i = 0; i < open.size();) {
+                        if (open[i].revents == 0) {
+                            ++i;
+                            continue;
+                        }
+                        FrameHeader header;
+                        if (!recvAll(open[i].fd, &header, sizeof(header))) {
+                            std::cerr << "Worker " << self << ": lost connection to worker " << openPeers[i] << std::endl;
+                            ok = false;
+                            return;
+                        }
+                        if (header.keyCount == 0) {
+                            open.erase(open.begin() + static_cast<long>(i));
+                            openPeers.erase(openPeers.begin() + static_cast<long>(i));
+                            continue;
+                        }
+                        payload.resize(header.payloadBytes);
+                        if (!recvAll(open[i].fd, payload.data(), payload.size())) {
+                            ok = false;
+                            return;
+                        }
+                        size_t offset = 0;
+                        for (uint32_t k = 0; k < header.keyCount; ++k) {
+                            uint32_t length;
+                            std::memcpy(&length, payload.data() + offset, sizeof(length));
+                            offset += sizeof(length);
+                            keys.emplace_back(payload, offset, length);
+                            offset += length;
+                        }
+                        open[i].revents = 0;
+                        ++i;
+                    }
+                }
+            }
+    };
+}
+
+double DistributedSorter::RunResult::maxLoadMs() const {
+    double result = 0.0;
+    for (const auto &report : reports) result = std::max(result, report.loadMs);
+    return result;
+}
+
+double DistributedSorter::RunResult::maxSampleMs() const {
+    double result = 0.0;
+    for (const auto &report : reports) result = std::max(result, report.sampleMs);
+    return result;
+}
+
+double DistributedSorter::RunResult::maxExchangeMs() const {
+    double result = 0.0;
+    for (const auto &report : reports) result = std::max(result, report.exchangeMs);
+    return result;
+}
+
+double DistributedSorter::RunResult::maxSortMs() const {
+    double result = 0.0;
+    for (const auto &report : reports) result = std::max(result, report.sortMs);
+    return result;
+}
+
+double DistributedSorter::RunResult::maxWriteMs() const {
+    double result = 0.0;
+    for (const auto &report : reports) result = std::max(result, report.writeMs);
+    return result;
+}
+
+DistributedSorter::DistributedSorter() : DistributedSorter(Options()) {}
+
+DistributedSorter::DistributedSorter(Options options) : options(options) {
+    if (this->options.batchBytes == 0) this->options.batchBytes = 1 << 16;
+    if (this->options.samplesPerWorker < 1) this->options.samplesPerWorker = 1;
+}
+
+DistributedSorter::WorkerReport DistributedSorter::runWorker(int worker, const std::string &shardFile,
+                                                             const std::string &outputFile,
+                                                             const std::vector<int> &peerFds,
+                                                             int controlFd) const {
+    WorkerReport report{worker, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, false};
+    int workers = static_cast<int>(peerFds.size());
+
+    auto start = Clock::now();
+    std::vector<std::string> keys;
+    std::string error;
+    if (!loadShard(shardFile, keys, error)) {
+        std::cerr << "Worker " << worker << ": " << error << ": " << shardFile << std::endl;
+        char token = LOAD_FAILED_TOKEN;
+        sendAll(controlFd, &token, 1);
+        return report;
+    }
+    report.keysLoaded = static_cast<long long>(keys.size());
+    report.loadMs = elapsedMs(start, Clock::now());
+
+    // Wait until every worker has loaded its shard so the remaining phases start together.
+    char token = LOADED_TOKEN;
+    if (!sendAll(controlFd, &token, 1) || !recvAll(controlFd, &token, 1) || token != GO_TOKEN) return report;
+
+    start = Clock::now();
+    std::vector<std::string> samples;
+    if (!keys.empty()) {
+        std::mt19937 rng(static_cast<unsigned int>(worker) + 1);
+        std::uniform_int_distribution<size_t> indexDist(0, keys.size() - 1);
+        int sampleCount = options.samplesPerWorker * workers;
+        for (int s = 0; s < sampleCount; ++s) {
+            samples.push_back(keys[indexDist(rng)]);
+        }
+    }
+    PeerExchange sampleRound(peerFds, worker, options.batchBytes);
+    for (int dest = 0; dest < workers; ++dest) {
+        if (dest == worker) continue;
+        for (const auto &sample : samples) sampleRound.send(dest, sample);
+    }
+    std::vector<std::string> allSamples;
+    if (!sampleRound.finish(allSamples)) return report;
+    allSamples.insert(allSamples.end(), samples.begin(), samples.end());
+    stringRadixSort(allSamples);
+
+    std::vector<std::string> splitters;
+    if (!allSamples.empty()) {
+        for (int j = 1; j < workers; ++j) {
+            splitters.push_back(allSamples[allSamples.size() * j / workers]);
+        }
+    }
+    report.sampleMs = elapsedMs(start, Clock::now());
+
+    start = Clock::now();
+    std::vector<std::string> owned;
+    PeerExchange keyRound(peerFds, worker, options.batchBytes);
+    for (auto &key : keys) {
+        int dest = static_cast<int>(std::upper_bound(splitters.begin(), splitters.end(), key) - splitters.begin());
+        if (dest == worker) {
+            owned.push_back(std::move(key));
+        } else {
+            keyRound.send(dest, key);
+        }
+    }
+    keys.clear();
+    keys.shrink_to_fit();
+
+    std::vector<std::string> received;
+    if (!keyRound.finish(received)) return report;
+    owned.reserve(owned.size() + received.size());
+    std::move(received.begin(), received.end(), std::back_inserter(owned));
+    received.clear();
+    report.keysSent = keyRound.getKeysSent();
+    report.bytesSent = sampleRound.getBytesSent() + keyRound.getBytesSent();
+    report.keysOwned = static_cast<long long>(owned.size());
+    report.exchangeMs = elapsedMs(start, Clock::now());
+
+    start = Clock::now();
+    stringRadixSort(owned);
+    report.sortMs = elapsedMs(start, Clock::now());
+
+    start = Clock::now();
+    if (!writePart(outputFile, owned)) {
+        std::cerr << "Worker " << worker << ": cannot write " << outputFile << std::endl;
+        return report;
+    }
+    report.writeMs = elapsedMs(start, Clock::now());
+
+    report.ok = true;
+    return report;
+}
+
+DistributedSorter::RunResult DistributedSorter::run(const std::vector<std::string> &shardFiles,
+                                                    const std::string &outputDir) const {
+    RunResult result{static_cast<int>(shardFiles.size()), 0.0, {}, {}, false};
+    int workers = result.workers;
+    if (workers == 0) return result;
+
+    std::error_code error;
+    std::filesystem::create_directories(outputDir, error);
+    if (error) {
+        std::cerr << "Error: cannot create output directory " << outputDir << ": " << error.message() << std::endl;
+        return result;
+    }
+    for (int i = 0; i < workers; ++i) {
+        result.outputFiles.push_back(outputDir + "/part_" + std::to_string(i) + ".txt");
+    }
+    removeStaleParts(outputDir, workers);
+
+    // peerFds[i][j] is worker i's end of the socket connecting it to worker j.
+    std::vector<std::vector<int>> peerFds(workers, std::vector<int>(workers, -1));
+    std::vector<int> coordinatorFds(workers, -1);
+    std::vector<int> workerControlFds(workers, -1);
+    for (int i = 0; i < workers; ++i) {
+        for (int j = i + 1; j < workers; ++j) {
+            int pair[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+                std::cerr << "Error: socketpair failed: " << std::strerror(errno) << std::endl;
+                return result;
+            }
+            peerFds[i][j] = pair[0];
+            peerFds[j][i] = pair[1];
+        }
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+            std::cerr << "Error: socketpair failed: " << std::strerror(errno) << std::endl;
+            return result;
+        }
+        coordinatorFds[i] = pair[0];
+        workerControlFds[i] = pair[1];
+    }
+
+    auto closeAll = [](const std::vector<int> &fds, int keep) {
+        for (size_t k = 0; k < fds.size(); ++k) {
+            if (fds[k] >= 0 && static_cast<int>(k) != keep) close(fds[k]);
+        }
+    };
+
+    std::cout.flush();
+    std::cerr.flush();
+
+    auto wallStart = Clock::now();
+    std::vector<pid_t> pids;
+    for (int i = 0; i < workers; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Error: fork failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (pid == 0) {
+            for (int k = 0; k < workers; ++k) {
+                if (k != i) closeAll(peerFds[k], -1);
+            }
+            closeAll(coordinatorFds, -1);
+            closeAll(workerControlFds, i);
+
+            WorkerReport report = runWorker(i, shardFiles[i], result.outputFiles[i], peerFds[i], workerControlFds[i]);
+            sendAll(workerControlFds[i], &report, sizeof(report));
+            _exit(report.ok ? 0 : 1);
+        }
+        pids.push_back(pid);
+    }
+
+    for (int i = 0; i < workers; ++i) closeAll(peerFds[i], -1);
+    closeAll(workerControlFds, -1);
+
+    bool ok = static_cast<int>(pids.size()) == workers;
+    if (ok) {
+        char token;
+        for (int i = 0; i < workers && ok; ++i) {
+            ok = recvAll(coordinatorFds[i], &token, 1) && token == LOADED_TOKEN;
+            if (!ok) std::cerr << "Error: worker " << i << " could not load its shard" << std::endl;
+        }
+        token = GO_TOKEN;
+        for (int i = 0; i < workers && ok; ++i) ok = sendAll(coordinatorFds[i], &token, 1);
+    }
+    for (int i = 0; i < workers && ok; ++i) {
+        WorkerReport report;
+        ok = recvAll(coordinatorFds[i], &report, sizeof(report)) && report.ok;
+        if (ok) result.reports.push_back(report);
+    }
+    if (!ok) {
+        std::cerr << "Error: a worker failed, stopping the run" << std::endl;
+        for (pid_t pid : pids) kill(pid, SIGTERM);
+    }
+
+    for (pid_t pid : pids) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+    }
+    closeAll(coordinatorFds, -1);
+
+    result.wallTimeMs = elapsedMs(wallStart, Clock::now());
+    result.ok = ok;
+    return result;
+}
+
+void DistributedSorter::printRunSummary(const RunResult &result) {
+    std::cout << "\n--- Distributed Sort: " << result.workers << " workers ---" << std::endl;
+    for (const auto &report : result.reports) {
+        std::cout << "Worker: " << std::setw(2) << std::right << report.worker
+                << " | Loaded: " << std::setw(9) << report.keysLoaded
+                << " | Sent: " << std::setw(9) << report.keysSent
+                << " | Owned: " << std::setw(9) << report.keysOwned
+                << " | Load: " << std::setw(9) << std::fixed << std::setprecision(3) << report.loadMs << " ms"
+                << " | Sample: " << std::setw(8) << report.sampleMs << " ms"
+                << " | Exchange: " << std::setw(9) << report.exchangeMs << " ms"
+                << " | Sort: " << std::setw(9) << report.sortMs << " ms"
+                << " | Write: " << std::setw(9) << report.writeMs << " ms" << std::endl;
+    }
+    std::cout << "Slowest worker: load " << std::fixed << std::setprecision(3) << result.maxLoadMs()
+            << " ms, sample " << result.maxSampleMs()
+            << " ms, exchange " << result.maxExchangeMs()
+            << " ms, sort " << result.maxSortMs()
+            << " ms, write " << result.maxWriteMs() << " ms" << std::endl;
+    std::cout << "Wall: " << result.wallTimeMs << " ms" << (result.ok ? "" : " (FAILED!)") << std::endl;
+    std::cout << "-----------------------" << std::endl;
+}
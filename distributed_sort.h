@@ -0,0 +1,70 @@
+#ifndef DISTRIBUTED_SORT_H
+#define DISTRIBUTED_SORT_H
+
+#include <string>
+#include <vector>
+
+// Sorts keys spread over several shard files with one worker process per shard.
+// Workers are forked locally and connected pairwise with Unix domain sockets:
+//   load   - each worker loads its shard (StringGenerator file format)
+//   sample - workers exchange random samples and all pick the same P-1 splitters
+//   exchange - every key is sent in batches to the worker owning its key range
+//   sort   - each worker sorts its range with stringRadixSort
+//   write  - worker i writes its range to outputDir/part_<i>.txt
+// Each part is in StringGenerator file format (a key count line, then the keys), so the
+// keys of the parts taken in worker order, without the count lines, are the globally
+// sorted output. part_<i>.txt files left in outputDir by an earlier run with more workers
+// are removed.
+class DistributedSorter {
+    public:
+        struct Options {
+            size_t batchBytes = 1 << 16;    // serialized keys per message
+            int samplesPerWorker = 64;      // samples each worker sends, per worker in the run
+        };
+
+        struct WorkerReport {
+            int worker;
+            long long keysLoaded;
+            long long keysSent;         // keys sent to other workers
+            long long keysOwned;        // keys in this worker's range after the exchange
+            long long bytesSent;
+            double loadMs;
+            double sampleMs;
+            double exchangeMs;
+            double sortMs;
+            double writeMs;
+            bool ok;
+        };
+
+        struct RunResult {
+            int workers;
+            double wallTimeMs;
+            std::vector<WorkerReport> reports;
+            std::vector<std::string> outputFiles;
+            bool ok;
+
+            // Phase time of the slowest worker, which bounds the run.
+            double maxLoadMs() const;
+            double maxSampleMs() const;
+            double maxExchangeMs() const;
+            double maxSortMs() const;
+            double maxWriteMs() const;
+        };
+
+    private:
+        Options options;
+
+        WorkerReport runWorker(int worker, const std::string& shardFile, const std::string& outputFile,
+                               const std::vector<int>& peerFds, int controlFd) const;
+
+    public:
+        DistributedSorter();
+        explicit DistributedSorter(Options options);
+
+        // Starts one worker per shard file and waits for all of them.
+        RunResult run(const std::vector<std::string>& shardFiles, const std::string& outputDir) const;
+
+        static void printRunSummary(const RunResult& result);
+};
+
+#endif // DISTRIBUTED_SORT_H
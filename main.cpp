@@ -1,10 +1,245 @@
 #include <iostream>
+#include <fstream>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <vector>
 #include <string>
 
 #include "string_sort_tester.h"
+#include "stream_sort.h"
+#include "distributed_sort.h"
+#include "sort.h"
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "  " << program << "                      run the benchmark" << std::endl;
+    std::cerr << "  " << program << " sort [options] [file]  sort keys (one per line) from file or stdin" << std::endl;
+    std::cerr << "  " << program << " incremental [batchSize] [numBatches]  benchmark batched ingest vs full re-sort" << std::endl;
+    std::cerr << "  " << program << " digits [size]        compare 8-bit and 16-bit radix digits on random data" << std::endl;
+    std::cerr << "  " << program << " distributed [-o DIR] shard...  sort shard files with one worker process each" << std::endl;
+    std::cerr << "  " << program << " distributed-bench [totalKeys] [maxWorkers]  benchmark 1..maxWorkers workers" << std::endl;
+    std::cerr << "  " << program << " check [size]         sort non-ASCII keys in chunks with every engine and verify the order" << std::endl;
+    std::cerr << "  " << program << " layout [size] [threads] [node]  compare sequential, shuffled and first-touch key layouts" << std::endl;
+    std::cerr << "Sort options:" << std::endl;
+    std::cerr << "  --algo merge|quick|radix|radix+quick  engine used for each chunk (default: radix)" << std::endl;
+    std::cerr << "  --chunk N                             keys per sorted chunk (default: 65536)" << std::endl;
+    std::cerr << "  --threads N                           sort stage workers (default: 1)" << std::endl;
+    std::cerr << "  --queue N                             capacity of each pipeline queue (default: 4)" << std::endl;
+    std::cerr << "  --header                              skip the leading key count line" << std::endl;
+    std::cerr << "  -o FILE                               write output to FILE instead of stdout" << std::endl;
+    std::cerr << "  --quiet                               do not print pipeline stats to stderr" << std::endl;
+}
+
+// Parses a whole argument as an int of at least minValue; anything else (text, trailing
+// characters, smaller or out of range values) is rejected.
+static bool parseIntAtLeast(const char* text, int minValue, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < minValue || parsed > INT_MAX) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+static bool parsePositiveInt(const char* text, int& value) {
+    return parseIntAtLeast(text, 1, value);
+}
+
+// Reads the optional positional argument argv[index] into value, leaving the default if it is absent.
+static bool parseOptionalPositiveInt(int argc, char* argv[], int index, int& value) {
+    return index >= argc || parsePositiveInt(argv[index], value);
+}
+
+static StreamSorter::SortFunction findSortFunction(const std::string& name) {
+    if (name == "merge") return stringMergeSort;
+    if (name == "quick") return stringQuickSort;
+    if (name == "radix") return stringRadixSort;
+    if (name == "radix+quick") return stringRadixSortWithQuickSwitch;
+    return nullptr;
+}
+
+static int runSortMode(int argc, char* argv[]) {
+    StreamSorter::Options options;
+    std::string algoName = "radix";
+    std::string inputFile;
+    std::string outputFile;
+    bool quiet = false;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        int value = 0;
+        if (arg == "--algo" && hasValue) {
+            algoName = argv[++i];
+        } else if (arg == "--chunk" && hasValue && parsePositiveInt(argv[i + 1], value)) {
+            options.chunkKeys = value;
+            ++i;
+        } else if (arg == "--threads" && hasValue && parsePositiveInt(argv[i + 1], value)) {
+            options.sortThreads = value;
+            ++i;
+        } else if (arg == "--queue" && hasValue && parsePositiveInt(argv[i + 1], value)) {
+            options.queueCapacity = value;
+            ++i;
+        } else if (arg == "--header") {
+            options.skipCountHeader = true;
+        } else if (arg == "-o" && hasValue) {
+            outputFile = argv[++i];
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (!arg.empty() && arg[0] != '-' && inputFile.empty()) {
+            inputFile = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    StreamSorter::SortFunction sortFunc = findSortFunction(algoName);
+    if (!sortFunc) {
+        std::cerr << "Error: Unknown sort algorithm: " << algoName << std::endl;
+        return 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    std::ifstream inFile;
+    if (!inputFile.empty()) {
+        inFile.open(inputFile, std::ios::binary);
+        if (!inFile.is_open()) {
+            std::cerr << "Error: Could not open file for reading: " << inputFile << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream outFile;
+    if (!outputFile.empty()) {
+        outFile.open(outputFile, std::ios::binary);
+        if (!outFile.is_open()) {
+            std::cerr << "Error: Could not open file for writing: " << outputFile << std::endl;
+            return 1;
+        }
+    }
+
+    StreamSorter sorter(sortFunc, options);
+    bool ok = sorter.run(inputFile.empty() ? std::cin : inFile, outputFile.empty() ? std::cout : outFile);
+
+    if (!quiet) sorter.printStats(std::cerr);
+    return ok ? 0 : 1;
+}
+
+static int runIncrementalMode(int argc, char* argv[]) {
+    int batchSize = 1000;
+    int numBatches = 100;
+    if (argc > 4 || !parseOptionalPositiveInt(argc, argv, 2, batchSize) ||
+        !parseOptionalPositiveInt(argc, argv, 3, numBatches)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    StringSortTester tester;
+    tester.runIncrementalExperiments(batchSize, numBatches);
+
+    tester.printIncrementalResultsSummary();
+    tester.saveIncrementalResultsToCsv("incremental_performance.csv");
+    return 0;
+}
+
+static int runDigitsMode(int argc, char* argv[]) {
+    int size = 1000000;
+    if (argc > 3 || !parseOptionalPositiveInt(argc, argv, 2, size)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    StringSortTester tester;
+    tester.runDigitWidthExperiment(size);
+    return 0;
+}
+
+static int runDistributedMode(int argc, char* argv[]) {
+    std::string outputDir = "distributed_output";
+    std::vector<std::string> shardFiles;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else {
+            shardFiles.push_back(arg);
+        }
+    }
+    if (shardFiles.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    DistributedSorter sorter;
+    DistributedSorter::RunResult result = sorter.run(shardFiles, outputDir);
+    DistributedSorter::printRunSummary(result);
+    return result.ok ? 0 : 1;
+}
+
+static int runDistributedBenchMode(int argc, char* argv[]) {
+    int totalKeys = 1000000;
+    int maxWorkers = 8;
+    if (argc > 4 || !parseOptionalPositiveInt(argc, argv, 2, totalKeys) ||
+        !parseOptionalPositiveInt(argc, argv, 3, maxWorkers)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<int> workerCounts;
+    for (int workers = 1; workers <= maxWorkers; workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+
+    StringSortTester tester;
+    tester.runDistributedExperiments(totalKeys, workerCounts);
+    return 0;
+}
+
+static int runCheckMode(int argc, char* argv[]) {
+    int size = 20000;
+    if (argc > 3 || !parseOptionalPositiveInt(argc, argv, 2, size)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    StringSortTester tester;
+    return tester.runStreamSortCheck(size) ? 0 : 1;
+}
+
+static int runLayoutMode(int argc, char* argv[]) {
+    int size = 100000;
+    int threads = 0;
+    int numaNode = -1;
+    if (argc > 5 || !parseOptionalPositiveInt(argc, argv, 2, size) ||
+        !parseOptionalPositiveInt(argc, argv, 3, threads) ||
+        (argc > 4 && !parseIntAtLeast(argv[4], 0, numaNode))) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    StringSortTester tester;
+    tester.runLayoutExperiments(size, 3, threads, numaNode);
+
+    tester.printResultsSummary();
+    tester.saveResultsToCsv("layout_performance.csv");
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        if (std::string(argv[1]) == "sort") return runSortMode(argc, argv);
+        if (std::string(argv[1]) == "incremental") return runIncrementalMode(argc, argv);
+        if (std::string(argv[1]) == "digits") return runDigitsMode(argc, argv);
+        if (std::string(argv[1]) == "distributed") return runDistributedMode(argc, argv);
+        if (std::string(argv[1]) == "distributed-bench") return runDistributedBenchMode(argc, argv);
+        if (std::string(argv[1]) == "layout") return runLayoutMode(argc, argv);
+        if (std::string(argv[1]) == "check") return runCheckMode(argc, argv);
+        printUsage(argv[0]);
+        return 1;
+    }
 
-int main() {
     std::cout << "==== String Sorting Algorithm Benchmark using StringSortTester ====" << std::endl;
     std::cout << "Each test will be run multiple times to get an accurate average." << std::endl;
     std::cout << "=================================================================\n" << std::endl;
@@ -1,26 +1,15 @@
 #include "sort.h"
+#include "sort_kernels.h"
 
 using namespace std;
 
-static int lcp(const string& a, const string& b, int start = 0, int* comparisons = nullptr) {
-    int len = min(a.length(), b.length());
-    int i;
-    for (i = start; i < len; i++) {
-        if (comparisons) (*comparisons)++;
-        if (a[i] != b[i]) {
-            break;
-        }
-    }
-    return i;
-}
-
 bool lcpCompare(const string& a, const string& b, int* comparisons = nullptr) {
     int commonPrefix = lcp(a, b, 0, comparisons);
     if (commonPrefix == min(a.length(), b.length())) {
         return a.length() < b.length();
     } else {
         if (comparisons) (*comparisons)++;
-        return a[commonPrefix] < b[commonPrefix];
+        return static_cast<unsigned char>(a[commonPrefix]) < static_cast<unsigned char>(b[commonPrefix]);
     }
 }
 
@@ -31,22 +20,22 @@ int merge(vector<string>& arr, int left, int mid, int right, vector<string>& tem
 
     while (i <= mid && j <= right) {
         if (lcpCompare(arr[i], arr[j], &comparisons)) {
-            temp[k++] = arr[i++];
+            temp[k++] = std::move(arr[i++]);
         } else {
-            temp[k++] = arr[j++];
+            temp[k++] = std::move(arr[j++]);
         }
     }
 
     while (i <= mid) {
-        temp[k++] = arr[i++];
+        temp[k++] = std::move(arr[i++]);
     }
 
     while (j <= right) {
-        temp[k++] = arr[j++];
+        temp[k++] = std::move(arr[j++]);
     }
 
     for (i = 0; i < k; i++) {
-        arr[left + i] = temp[i];
+        arr[left + i] = std::move(temp[i]);
     }
     
     return comparisons;
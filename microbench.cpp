@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MICROBENCH_HAS_TSC 1
+#endif
+
+#include "sort_kernels.h"
+#include "radix_pass.h"
+
+// Microbenchmarks for the inner loops of the sort engines, run over synthetic inputs whose
+// prefix lengths, string lengths and bucket counts are fixed per case. Results are written
+// as JSON: ns/op is the median over samples, bytes/cycle uses the time stamp counter.
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const std::string ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!@#%:;^&*()-.";
+
+    volatile long long sink = 0;
+
+    struct BenchmarkResult {
+        std::string kernel;
+        std::vector<std::pair<std::string, long long>> params;
+        long long opsPerRun;
+        double nsPerOp;
+        double nsPerOpMin;
+        double bytesPerCycle;   // negative if cycles are not available
+    };
+
+    inline uint64_t readCycles() {
+#ifdef MICROBENCH_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    std::string randomString(std::mt19937 &rng, int length, int alphabetSize) {
+        std::uniform_int_distribution<int> charDist(0, alphabetSize - 1);
+        std::string result;
+        result.reserve(length);
+        for (int i = 0; i < length; i++) {
+            result.push_back(ALPHABET[charDist(rng)]);
+        }
+        return result;
+    }
+
+    std::vector<std::string> randomStrings(std::mt19937 &rng, int count, int length, int alphabetSize,
+                                           const std::string &prefix = "") {
+        std::vector<std::string> result;
+        result.reserve(count);
+        for (int i = 0; i < count; i++) {
+            result.push_back(prefix + randomString(rng, length, alphabetSize));
+        }
+        return result;
+    }
+
+    // Runs setup() outside and body() inside the timed region; body returns the bytes it processed.
+    template <typename Setup, typename Body>
+    BenchmarkResult measure(const std::string &kernel, std::vector<std::pair<std::string, long long>> params,
+                            long long opsPerRun, int samples, Setup setup, Body body) {
+        const int warmupRuns = 2;
+        std::vector<double> nsPerOp;
+        long long totalBytes = 0;
+        uint64_t totalCycles = 0;
+
+        for (int run = 0; run < warmupRuns + samples; ++run) {
+            setup();
+            auto startTime = Clock::now();
+            uint64_t startCycles = readCycles();
+            long long bytes = body();
+            uint64_t endCycles = readCycles();
+            auto endTime = Clock::now();
+
+            if (run < warmupRuns) continue;
+            double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+            nsPerOp.push_back(ns / opsPerRun);
+            totalBytes += bytes;
+            totalCycles += endCycles - startCycles;
+        }
+
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+        double bytesPerCycle = totalCycles > 0 ? static_cast<double>(totalBytes) / totalCycles : -1.0;
+        return {kernel, std::move(params), opsPerRun, nsPerOp[nsPerOp.size() / 2], nsPerOp.front(), bytesPerCycle};
+    }
+
+    void benchmarkLcp(std::vector<BenchmarkResult> &results, int samples) {
+        const int pairs = 1 << 14;
+        for (int prefixLength : {0, 8, 32, 128, 512}) {
+            std::mt19937 rng(1);
+            std::string prefix = randomString(rng, prefixLength, static_cast<int>(ALPHABET.size()));
+            std::vector<std::pair<std::string, std::string>> input;
+            input.reserve(pairs);
+            for (int i = 0; i < pairs; i++) {
+                std::string a = prefix + "A" + randomString(rng, 15, static_cast<int>(ALPHABET.size()));
+                std::string b = prefix + "B" + randomString(rng, 15, static_cast<int>(ALPHABET.size()));
+                input.push_back({std::move(a), std::move(b)});
+            }
+
+            results.push_back(measure("lcp", {{"prefix_length", prefixLength}, {"string_length", prefixLength + 16}},
+                                      pairs, samples, [] {}, [&] {
+                long long total = 0;
+                for (const auto &pair : input) total += lcp(pair.first, pair.second);
+                sink = sink + total;
+                // Both strings are read up to and including the first mismatch.
+                return 2LL * (total + pairs);
+            }));
+        }
+    }
+
+    void benchmarkCharAtPos(std::vector<BenchmarkResult> &results, int samples) {
+        const int count = 1 << 16;
+        for (int length : {16, 100, 200}) {
+            std::mt19937 rng(2);
+            std::vector<std::string> input = randomStrings(rng, count, length, static_cast<int>(ALPHABET.size()));
+            // Some positions fall past the end, as they do for short keys in the radix engines.
+            std::uniform_int_distribution<int> positionDist(0, length + length / 8);
+            std::vector<int> positions(count);
+            for (int &d : positions) d = positionDist(rng);
+
+            results.push_back(measure("charAtPos", {{"string_length", length}, {"strings", count}},
+                                      count, samples, [] {}, [&] {
+                long long total = 0;
+                for (int i = 0; i < count; i++) total += static_cast<unsigned char>(charAtPos(input[i], positions[i]));
+                sink = sink + total;
+                return static_cast<long long>(count);
+            }));
+        }
+    }
+
+    void benchmarkRadixRead(std::vector<BenchmarkResult> &results, int samples) {
+        const int count = 1 << 16;
+        for (int length : {16, 100}) {
+            for (int width = 1; width <= 2; ++width) {
+                std::mt19937 rng(3);
+                std::vector<std::string> input = randomStrings(rng, count, length, static_cast<int>(ALPHABET.size()));
+                std::vector<uint32_t> cached;
+
+                results.push_back(measure("radix_read", {{"string_length", length}, {"digit_bits", width * 8}},
+                                          count, samples, [] {}, [&] {
+                    RadixDigitMap map = radixReadDigits(input, 0, count - 1, 0, width == 2, cached, nullptr);
+                    sink = sink + map.buckets;
+                    return static_cast<long long>(count) * width;
+                }));
+            }
+        }
+    }
+
+    // Inputs whose first two characters come from alphabetSize symbols, so a pass over them
+    // has alphabetSize + 1 one-byte buckets or (alphabetSize + 1)^2 two-byte buckets.
+    struct DigitInput {
+        std::vector<std::string> strings;
+        std::vector<uint32_t> cached;
+        RadixDigitMap map;
+    };
+
+    DigitInput makeDigitInput(int count, int alphabetSize, bool twoByte) {
+        std::mt19937 rng(4);
+        DigitInput input;
+        input.strings = randomStrings(rng, count, 100, alphabetSize);
+        input.map = radixReadDigits(input.strings, 0, count - 1, 0, twoByte, input.cached, nullptr);
+        return input;
+    }
+
+    void benchmarkRadixCount(std::vector<BenchmarkResult> &results, int samples) {
+        const int count = 1 << 16;
+        for (int width = 1; width <= 2; ++width) {
+            for (int alphabetSize : {1, 15, 75}) {
+                DigitInput input = makeDigitInput(count, alphabetSize, width == 2);
+                std::vector<int> buckets;
+
+                results.push_back(measure("radix_count", {{"buckets", input.map.buckets}, {"digit_bits", input.map.twoByte ? 16 : 8}},
+                                          count, samples, [] {}, [&] {
+                    radixCountDigits(input.cached, input.map, buckets);
+                    sink = sink + buckets.back();
+                    return static_cast<long long>(count * sizeof(uint32_t));
+                }));
+            }
+        }
+    }
+
+    void benchmarkRadixDistribute(std::vector<BenchmarkResult> &results, int samples) {
+        const int count = 1 << 16;
+        for (int width = 1; width <= 2; ++width) {
+            for (int alphabetSize : {1, 15, 75}) {
+                DigitInput input = makeDigitInput(count, alphabetSize, width == 2);
+                std::vector<int> starts;
+                radixCountDigits(input.cached, input.map, starts);
+                std::vector<int> positions;
+                std::vector<std::string> aux;
+                std::vector<std::string> arr;
+
+                results.push_back(measure("radix_distribute", {{"buckets", input.map.buckets}, {"digit_bits", input.map.twoByte ? 16 : 8}},
+                                          count, samples, [&] {
+                    arr = input.strings;
+                    positions = starts;
+                }, [&] {
+                    radixDistributeDigits(arr, 0, input.cached, input.map, positions, aux);
+                    // Every string object is moved into aux and back.
+                    return static_cast<long long>(2 * count * sizeof(std::string));
+                }));
+            }
+        }
+    }
+
+    void benchmarkPartition(std::vector<BenchmarkResult> &results, int samples) {
+        const int count = 1 << 15;
+        for (int prefixLength : {0, 32}) {
+            for (int distinctKeys : {2, 64, count}) {
+                std::mt19937 rng(5);
+                std::string prefix = randomString(rng, prefixLength, static_cast<int>(ALPHABET.size()));
+                std::vector<std::string> keys = randomStrings(rng, distinctKeys, 16, static_cast<int>(ALPHABET.size()), prefix);
+                std::uniform_int_distribution<int> keyDist(0, distinctKeys - 1);
+                std::vector<std::string> input;
+                input.reserve(count);
+                for (int i = 0; i < count; i++) input.push_back(keys[keyDist(rng)]);
+
+                std::vector<std::string> arr;
+                results.push_back(measure("partition_3way",
+                                          {{"prefix_length", prefixLength}, {"distinct_keys", distinctKeys}, {"strings", count}},
+                                          count, samples, [&] { arr = input; }, [&] {
+                    int lt, gt;
+                    int comparisons = partitionThreeWay(arr, 0, count - 1, lt, gt, 0);
+                    sink = sink + lt + gt;
+                    // Each character comparison reads one byte of the key and one of the pivot.
+                    return 2LL * comparisons;
+                }));
+            }
+        }
+    }
+
+    std::string toJson(const std::vector<BenchmarkResult> &results) {
+        std::ostringstream os;
+        os << std::fixed;
+        os << "{\n";
+#ifdef __OPTIMIZE__
+        os << "  \"optimized\": true,\n";
+#else
+        os << "  \"optimized\": false,\n";
+#endif
+        os << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult &res = results[i];
+            os << "    {\"kernel\": \"" << res.kernel << "\", \"params\": {";
+            for (size_t p = 0; p < res.params.size(); ++p) {
+                os << (p ? ", " : "") << "\"" << res.params[p].first << "\": " << res.params[p].second;
+            }
+            os << "}, \"ops_per_run\": " << res.opsPerRun
+               << ", \"ns_per_op\": " << std::setprecision(3) << res.nsPerOp
+               << ", \"ns_per_op_min\": " << res.nsPerOpMin
+               << ", \"bytes_per_cycle\": ";
+            if (res.bytesPerCycle < 0) {
+                os << "null";
+            } else {
+                os << std::setprecision(4) << res.bytesPerCycle;
+            }
+            os << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+        return os.str();
+    }
+}
+
+// Parses a whole argument as a positive int, like the one in main.cpp.
+static bool parsePositiveInt(const char *text, int &value) {
+    char *end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed <= 0 || parsed > INT_MAX) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    std::string outputFile;
+    std::string filter;
+    int samples = 11;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc && parsePositiveInt(argv[i + 1], samples)) {
+            ++i;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [-o FILE] [--samples N] [--filter KERNEL]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<std::pair<std::string, void (*)(std::vector<BenchmarkResult> &, int)>> kernels = {
+        {"lcp", benchmarkLcp},
+        {"charAtPos", benchmarkCharAtPos},
+        {"radix_read", benchmarkRadixRead},
+        {"radix_count", benchmarkRadixCount},
+        {"radix_distribute", benchmarkRadixDistribute},
+        {"partition_3way", benchmarkPartition},
+    };
+
+    std::vector<BenchmarkResult> results;
+    for (const auto &kernel : kernels) {
+        if (!filter.empty() && kernel.first != filter) continue;
+        std::cerr << "Running " << kernel.first << "..." << std::endl;
+        kernel.second(results, samples);
+    }
+
+    std::string json = toJson(results);
+    if (outputFile.empty()) {
+        std::cout << json;
+        return 0;
+    }
+
+    std::ofstream outFile(outputFile);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Could not open file for writing: " << outputFile << std::endl;
+        return 1;
+    }
+    outFile << json;
+    std::cout << "Results saved to " << outputFile << std::endl;
+    return 0;
+}
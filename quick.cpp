@@ -1,33 +1,15 @@
 #include <random>
 
 #include "sort.h"
+#include "sort_kernels.h"
 
 using namespace std;
 
-static int lcp(const string& a, const string& b, int start = 0, int* comparisons = nullptr) {
-    int len = min(a.length(), b.length());
-    int i;
-    for (i = start; i < len; i++) {
-        if (comparisons) (*comparisons)++;
-        if (a[i] != b[i]) {
-            break;
-        }
-    }
-    return i;
-}
-
-int stringQuickSortHelper(vector<string>& arr, int left, int right, int comparisons) {
-    if (left >= right) return comparisons;
-
-    mt19937 rng(random_device{}());
-    uniform_int_distribution<int> dist(left, right);
-    int pivotIndex = dist(rng);
-    swap(arr[left], arr[pivotIndex]);
-
+int partitionThreeWay(vector<string>& arr, int left, int right, int& lt, int& gt, int comparisons) {
     string pivot = arr[left];
 
-    int lt = left;
-    int gt = right;
+    lt = left;
+    gt = right;
     int i = left + 1;
 
     while (i <= gt) {
@@ -39,7 +21,8 @@ int stringQuickSortHelper(vector<string>& arr, int left, int right, int comparis
             cmp = (arr[i].length() < pivot.length()) ? -1 : (arr[i].length() > pivot.length() ? 1 : 0);
         } else {
             comparisons++;
-            cmp = (arr[i][commonPrefix] < pivot[commonPrefix]) ? -1 : 1;
+            // Bytes compare unsigned, the same order as std::string and the radix engines.
+            cmp = (static_cast<unsigned char>(arr[i][commonPrefix]) < static_cast<unsigned char>(pivot[commonPrefix])) ? -1 : 1;
         }
 
         if (cmp < 0) {
@@ -51,6 +34,20 @@ int stringQuickSortHelper(vector<string>& arr, int left, int right, int comparis
         }
     }
 
+    return comparisons;
+}
+
+int stringQuickSortHelper(vector<string>& arr, int left, int right, int comparisons) {
+    if (left >= right) return comparisons;
+
+    mt19937 rng(random_device{}());
+    uniform_int_distribution<int> dist(left, right);
+    int pivotIndex = dist(rng);
+    swap(arr[left], arr[pivotIndex]);
+
+    int lt, gt;
+    comparisons = partitionThreeWay(arr, left, right, lt, gt, comparisons);
+
     comparisons = stringQuickSortHelper(arr, left, lt - 1, comparisons);
     comparisons = stringQuickSortHelper(arr, gt + 1, right, comparisons);
     
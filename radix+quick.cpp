@@ -3,19 +3,13 @@
 #include <random>
 
 #include "sort.h"
+#include "radix_pass.h"
+#include "sort_kernels.h"
 
 using namespace std;
 
-const int ASCII_CHARACTER_RANGE = 256;
 const int MSD_TO_QUICK_SORT_THRESHOLD = 74;
 
-inline char charAtPos(const string &s, int d, int *comparisons = nullptr) {
-    if (d < s.length()) {
-        return s[d];
-    }
-    return 0;
-}
-
 static int lcp_for_quick(const string &a, const string &b, int start, int *comparisons) {
     int len_a = a.length();
     int len_b = b.length();
@@ -30,6 +24,12 @@ static int lcp_for_quick(const string &a, const string &b, int start, int *compa
     return i - start;
 }
 
+// Byte at position d as unsigned, or -1 past the end of the string, so that a '\0' byte
+// is not mistaken for the end of a shorter key.
+static int symbolAtPos(const string &s, int d) {
+    return d < static_cast<int>(s.length()) ? static_cast<unsigned char>(s[d]) : -1;
+}
+
 static int stringQuickSortHelperForRadixSwitch(vector<string> &arr, int left, int right, int d, int comparisons) {
     if (left >= right) return comparisons;
 
@@ -41,14 +41,14 @@ static int stringQuickSortHelperForRadixSwitch(vector<string> &arr, int left, in
     }
 
     string pivot_str = arr[left];
-    char pivot_char_at_d = charAtPos(pivot_str, d, nullptr);
+    int pivot_char_at_d = symbolAtPos(pivot_str, d);
 
     int lt = left;
     int gt = right;
     int i = left + 1;
 
     while (i <= gt) {
-        char current_char_at_d = charAtPos(arr[i], d, nullptr);
+        int current_char_at_d = symbolAtPos(arr[i], d);
         if (comparisons) (comparisons)++;
 
         if (current_char_at_d < pivot_char_at_d) {
@@ -61,7 +61,7 @@ static int stringQuickSortHelperForRadixSwitch(vector<string> &arr, int left, in
     }
 
     comparisons = stringQuickSortHelperForRadixSwitch(arr, left, lt - 1, d, comparisons);
-    if (pivot_char_at_d != 0) {
+    if (pivot_char_at_d >= 0) {
         comparisons = stringQuickSortHelperForRadixSwitch(arr, lt, gt, d + 1, comparisons);
     }
     comparisons = stringQuickSortHelperForRadixSwitch(arr, gt + 1, right, d, comparisons);
@@ -77,31 +77,11 @@ int msdRadixSortWithQuickSwitchRecursive(vector<string> &arr, int lo, int hi, in
         return comparisons;
     }
 
-    vector<int> count(ASCII_CHARACTER_RANGE + 2, 0);
-    vector<string> aux(hi - lo + 1);
-
-    for (int i = lo; i <= hi; i++) {
-        count[static_cast<unsigned char>(charAtPos(arr[i], d, nullptr)) + 2]++;
-    }
-
-    for (int r = 0; r < ASCII_CHARACTER_RANGE + 1; r++) {
-        count[r + 1] += count[r];
-    }
-
-    for (int i = lo; i <= hi; i++) {
-        aux[count[static_cast<unsigned char>(charAtPos(arr[i], d, nullptr)) + 1]++] = arr[i];
-    }
-
-    for (int i = lo; i <= hi; i++) {
-        arr[i] = aux[i - lo];
-    }
+    vector<RadixBucket> buckets;
+    msdRadixDistribute(arr, lo, hi, d, buckets, nullptr);
 
-    for (int r = 0; r < ASCII_CHARACTER_RANGE; r++) {
-        comparisons = msdRadixSortWithQuickSwitchRecursive(arr,
-                                                           lo + count[r],
-                                                           lo + count[r + 1] - 1,
-                                                           d + 1,
-                                                           comparisons);
+    for (const RadixBucket &bucket : buckets) {
+        comparisons = msdRadixSortWithQuickSwitchRecursive(arr, bucket.lo, bucket.hi, bucket.d, comparisons);
     }
 
     return comparisons;
@@ -2,40 +2,18 @@
 #include <vector>
 
 #include "sort.h"
+#include "radix_pass.h"
 
 using namespace std;
 
-inline char charAtPos(const string& s, int d, int* comparisons = nullptr) {
-    if (comparisons && d < s.length()) (*comparisons)++;
-    return d < s.length() ? s[d] : 0;
-}
-
 int msdRadixSort(vector<string>& arr, int lo, int hi, int d, int comparisons) {
     if (hi <= lo) return comparisons;
 
-    const int R = 256;
-
-    vector<string> aux(hi - lo + 1);
-    vector<int> count(R + 2, 0);
-
-    for (int i = lo; i <= hi; i++) {
-        count[charAtPos(arr[i], d, &comparisons) + 2]++;
-    }
-
-    for (int r = 0; r < R + 1; r++) {
-        count[r + 1] += count[r];
-    }
-
-    for (int i = lo; i <= hi; i++) {
-        aux[count[charAtPos(arr[i], d, &comparisons) + 1]++] = arr[i];
-    }
-
-    for (int i = lo; i <= hi; i++) {
-        arr[i] = aux[i - lo];
-    }
+    vector<RadixBucket> buckets;
+    msdRadixDistribute(arr, lo, hi, d, buckets, &comparisons);
 
-    for (int r = 0; r < R; r++) {
-        comparisons = msdRadixSort(arr, lo + count[r], lo + count[r + 1] - 1, d + 1, comparisons);
+    for (const RadixBucket& bucket : buckets) {
+        comparisons = msdRadixSort(arr, bucket.lo, bucket.hi, bucket.d, comparisons);
     }
     
     return comparisons;
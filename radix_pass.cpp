@@ -0,0 +1,128 @@
+#include <atomic>
+
+#include "radix_pass.h"
+#include "sort_kernels.h"
+
+using namespace std;
+
+// Below this size the second character is not read at all.
+const int TWO_BYTE_DIGIT_MIN_BUCKET = 128;
+// A 16-bit pass is used while the digit space is at most this many times the bucket size.
+// Clearing and scanning a sparse count array is cheap next to the extra pass over the
+// strings that a second 8-bit level would need.
+const int TWO_BYTE_DIGITS_PER_KEY = 32;
+
+static atomic<int> maxDigitWidth(2);
+// Per thread, so that engines sorting on several threads never share the counters' cache line.
+static thread_local RadixPassStats passStats = {0, 0, 0};
+
+// Symbol at position d: 0 past the end of the string, otherwise the byte plus one.
+static uint32_t symbolAtPos(const string &s, int d, int *comparisons) {
+    if (d >= static_cast<int>(s.length())) return 0;
+    return static_cast<unsigned char>(charAtPos(s, d, comparisons)) + 1;
+}
+
+// Gives every symbol seen in the bucket a dense rank in byte order; rank 0 is end of string.
+static int compactAlphabet(const bool seen[RADIX_SYMBOLS], int rank[RADIX_SYMBOLS]) {
+    int symbols = 1;
+    rank[0] = 0;
+    for (int c = 1; c < RADIX_SYMBOLS; c++) {
+        rank[c] = seen[c] ? symbols++ : 0;
+    }
+    return symbols;
+}
+
+RadixDigitMap radixReadDigits(const vector<string> &arr, int lo, int hi, int d, bool readSecond,
+                              vector<uint32_t> &cached, int *comparisons) {
+    int n = hi - lo + 1;
+    cached.resize(n);
+    bool seenFirst[RADIX_SYMBOLS] = {};
+    bool seenSecond[RADIX_SYMBOLS] = {};
+    for (int i = 0; i < n; i++) {
+        const string &s = arr[lo + i];
+        uint32_t s0 = symbolAtPos(s, d, comparisons);
+        uint32_t s1 = (readSecond && s0 != 0) ? symbolAtPos(s, d + 1, comparisons) : 0;
+        cached[i] = s0 << 16 | s1;
+        seenFirst[s0] = true;
+        seenSecond[s1] = true;
+    }
+
+    RadixDigitMap map;
+    map.symbolsFirst = compactAlphabet(seenFirst, map.rankFirst);
+    map.symbolsSecond = compactAlphabet(seenSecond, map.rankSecond);
+    // In long long: n * TWO_BYTE_DIGITS_PER_KEY overflows int once a bucket exceeds 2^26 keys.
+    map.twoByte = readSecond &&
+                  map.symbolsFirst * map.symbolsSecond <= static_cast<long long>(n) * TWO_BYTE_DIGITS_PER_KEY;
+    map.buckets = map.twoByte ? map.symbolsFirst * map.symbolsSecond : map.symbolsFirst;
+    return map;
+}
+
+void radixCountDigits(const vector<uint32_t> &cached, const RadixDigitMap &map, vector<int> &count) {
+    count.assign(map.buckets + 1, 0);
+    for (uint32_t key : cached) {
+        count[map.digitOf(key) + 1]++;
+    }
+
+    for (int b = 0; b < map.buckets; b++) {
+        count[b + 1] += count[b];
+    }
+}
+
+void radixDistributeDigits(vector<string> &arr, int lo, const vector<uint32_t> &cached,
+                           const RadixDigitMap &map, vector<int> &positions, vector<string> &aux) {
+    int n = static_cast<int>(cached.size());
+    aux.resize(n);
+    for (int i = 0; i < n; i++) {
+        aux[positions[map.digitOf(cached[i])]++] = std::move(arr[lo + i]);
+    }
+
+    for (int i = 0; i < n; i++) {
+        arr[lo + i] = std::move(aux[i]);
+    }
+}
+
+void msdRadixDistribute(vector<string> &arr, int lo, int hi, int d, vector<RadixBucket> &next, int *comparisons) {
+    int n = hi - lo + 1;
+    if (n <= 1) return;
+
+    bool readSecond = maxDigitWidth.load(memory_order_relaxed) >= 2 && n >= TWO_BYTE_DIGIT_MIN_BUCKET;
+
+    vector<uint32_t> cached;
+    RadixDigitMap map = radixReadDigits(arr, lo, hi, d, readSecond, cached, comparisons);
+
+    vector<int> start;
+    radixCountDigits(cached, map, start);
+
+    vector<int> positions(start);
+    vector<string> aux;
+    radixDistributeDigits(arr, lo, cached, map, positions, aux);
+
+    (map.twoByte ? passStats.twoByteLevels : passStats.oneByteLevels)++;
+    passStats.keysDistributed += n;
+
+    // Only end of string has rank 0, so a digit whose last symbol has rank 0 holds strings that
+    // all ended here; they are equal and finished. A '\0' byte has a rank of its own.
+    int nextD = d + (map.twoByte ? 2 : 1);
+    for (int b = 0; b < map.buckets; b++) {
+        bool finished = map.twoByte ? b % map.symbolsSecond == 0 : b == 0;
+        if (finished) continue;
+        if (start[b + 1] - start[b] < 2) continue;
+        next.push_back({lo + start[b], lo + start[b + 1] - 1, nextD});
+    }
+}
+
+void setRadixMaxDigitWidth(int width) {
+    maxDigitWidth.store(width >= 2 ? 2 : 1, memory_order_relaxed);
+}
+
+int getRadixMaxDigitWidth() {
+    return maxDigitWidth.load(memory_order_relaxed);
+}
+
+void resetRadixPassStats() {
+    passStats = {0, 0, 0};
+}
+
+RadixPassStats getRadixPassStats() {
+    return passStats;
+}
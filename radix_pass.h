@@ -0,0 +1,71 @@
+#ifndef RADIX_PASS_H
+#define RADIX_PASS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Sub-range left for the next MSD level: arr[lo..hi] still has to be sorted from position d.
+struct RadixBucket {
+    int lo;
+    int hi;
+    int d;
+};
+
+struct RadixPassStats {
+    long long oneByteLevels;    // passes that consumed one character
+    long long twoByteLevels;    // passes that consumed two characters
+    long long keysDistributed;  // strings moved by all passes
+};
+
+// Number of character symbols: 0 is end of string and byte c is c + 1, so a '\0' byte
+// inside a key stays distinct from the end of a shorter key.
+const int RADIX_SYMBOLS = 257;
+
+// Digit values for one pass. Symbols get dense ranks in byte order, rank 0 being end of string;
+// a 16-bit digit is rankFirst * symbolsSecond + rankSecond.
+struct RadixDigitMap {
+    bool twoByte;
+    int symbolsFirst;
+    int symbolsSecond;
+    int buckets;
+    int rankFirst[RADIX_SYMBOLS];
+    int rankSecond[RADIX_SYMBOLS];
+
+    int digitOf(uint32_t key) const {
+        int digit = rankFirst[key >> 16];
+        return twoByte ? digit * symbolsSecond + rankSecond[key & 0xFFFF] : digit;
+    }
+};
+
+// One MSD distribution pass over arr[lo..hi] at position d, shared by the radix engines.
+// The characters of each string are read once and cached, and only the symbols that occur
+// in this bucket get a digit value, so the 75-character generator alphabet needs 76 digits
+// per character (0 is end of string) instead of 257. Large buckets consume d and d+1 at once
+// (16-bit digits, 76^2 buckets); as buckets shrink the digit width is chosen from the bucket
+// size and falls back to one character. Buckets with two or more strings that have not
+// ended yet are appended to next. Character reads are added to *comparisons.
+void msdRadixDistribute(std::vector<std::string>& arr, int lo, int hi, int d,
+                        std::vector<RadixBucket>& next, int* comparisons);
+
+// The three steps of msdRadixDistribute, also used on their own by microbench.cpp.
+// Read: caches the symbols at d (and d+1 if readSecond) of arr[lo..hi] as (s0 << 16 | s1)
+// and builds the digit map for them.
+RadixDigitMap radixReadDigits(const std::vector<std::string>& arr, int lo, int hi, int d, bool readSecond,
+                              std::vector<uint32_t>& cached, int* comparisons);
+// Count: histogram of the cached digits turned into bucket starts; count gets map.buckets + 1 entries.
+void radixCountDigits(const std::vector<uint32_t>& cached, const RadixDigitMap& map, std::vector<int>& count);
+// Distribute: moves arr[lo..] into bucket order through aux. positions starts as a copy of the
+// bucket starts and ends as the bucket ends.
+void radixDistributeDigits(std::vector<std::string>& arr, int lo, const std::vector<uint32_t>& cached,
+                           const RadixDigitMap& map, std::vector<int>& positions, std::vector<std::string>& aux);
+
+// 2 enables 16-bit digits on large buckets (default), 1 forces one character per pass.
+void setRadixMaxDigitWidth(int width);
+int getRadixMaxDigitWidth();
+
+// Pass counters of the calling thread only; sorts run on other threads are not included.
+void resetRadixPassStats();
+RadixPassStats getRadixPassStats();
+
+#endif // RADIX_PASS_H
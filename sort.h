@@ -9,4 +9,8 @@ int stringQuickSort(std::vector<std::string>& arr);
 int stringRadixSort(std::vector<std::string>& arr);
 int stringRadixSortWithQuickSwitch(std::vector<std::string>& arr);
 
+// Merges the sorted ranges arr[left..mid] and arr[mid+1..right] in place using LCP comparisons.
+// temp must hold at least right - left + 1 elements. Returns comparisons plus those made here.
+int merge(std::vector<std::string>& arr, int left, int mid, int right, std::vector<std::string>& temp, int comparisons);
+
 #endif //SORTS_H
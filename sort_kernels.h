@@ -0,0 +1,36 @@
+#ifndef SORT_KERNELS_H
+#define SORT_KERNELS_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Inner loops shared by the sort engines. They live here so that the engines and
+// the microbenchmarks (microbench.cpp) run exactly the same code.
+
+// Length of the common prefix of a and b, scanning from start. Each character pair
+// examined is added to *comparisons.
+inline int lcp(const std::string& a, const std::string& b, int start = 0, int* comparisons = nullptr) {
+    int len = std::min(a.length(), b.length());
+    int i;
+    for (i = start; i < len; i++) {
+        if (comparisons) (*comparisons)++;
+        if (a[i] != b[i]) {
+            break;
+        }
+    }
+    return i;
+}
+
+// Character at position d, or 0 past the end of the string.
+inline char charAtPos(const std::string& s, int d, int* comparisons = nullptr) {
+    if (comparisons && d < s.length()) (*comparisons)++;
+    return d < s.length() ? s[d] : 0;
+}
+
+// 3-way partition of arr[left..right] around the pivot arr[left] using LCP comparisons:
+// afterwards arr[left..lt-1] < pivot, arr[lt..gt] == pivot and arr[gt+1..right] > pivot.
+// Returns comparisons plus those made here.
+int partitionThreeWay(std::vector<std::string>& arr, int left, int right, int& lt, int& gt, int comparisons);
+
+#endif // SORT_KERNELS_H
@@ -0,0 +1,130 @@
+#include <algorithm>
+
+#include "sorted_collection.h"
+#include "sort.h"
+
+SortedCollection::ConstIterator::ConstIterator(const std::vector<std::vector<std::string>> *levels,
+                                               std::vector<size_t> positions)
+    : levels(levels), positions(std::move(positions)) {
+    findCurrent();
+}
+
+void SortedCollection::ConstIterator::findCurrent() {
+    current = levels->size();
+    for (size_t i = 0; i < levels->size(); ++i) {
+        if (positions[i] >= (*levels)[i].size()) continue;
+        if (current == levels->size() || (*levels)[i][positions[i]] < (*levels)[current][positions[current]]) {
+            current = i;
+        }
+    }
+}
+
+SortedCollection::ConstIterator::reference SortedCollection::ConstIterator::operator*() const {
+    return (*levels)[current][positions[current]];
+}
+
+SortedCollection::ConstIterator::pointer SortedCollection::ConstIterator::operator->() const {
+    return &(*levels)[current][positions[current]];
+}
+
+SortedCollection::ConstIterator &SortedCollection::ConstIterator::operator++() {
+    positions[current]++;
+    findCurrent();
+    return *this;
+}
+
+SortedCollection::ConstIterator SortedCollection::ConstIterator::operator++(int) {
+    ConstIterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+bool SortedCollection::ConstIterator::operator==(const ConstIterator &other) const {
+    return levels == other.levels && positions == other.positions;
+}
+
+SortedCollection::SortedCollection(SortFunction sortFunc, size_t growthFactor)
+    : sortFunc(std::move(sortFunc)), growthFactor(growthFactor < 2 ? 2 : growthFactor) {}
+
+int SortedCollection::insertBatch(std::vector<std::string> batch) {
+    if (batch.empty()) return 0;
+
+    int comparisons = sortFunc(batch);
+    totalSize += batch.size();
+    levels.push_back(std::move(batch));
+    return compactLevels(comparisons);
+}
+
+int SortedCollection::compactLevels(int comparisons) {
+    while (levels.size() >= 2 && levels[levels.size() - 2].size() < growthFactor * levels.back().size()) {
+        std::vector<std::string> &older = levels[levels.size() - 2];
+        std::vector<std::string> &newer = levels.back();
+
+        int mid = static_cast<int>(older.size()) - 1;
+        older.reserve(older.size() + newer.size());
+        std::move(newer.begin(), newer.end(), std::back_inserter(older));
+        levels.pop_back();
+
+        if (mergeBuffer.size() < older.size()) mergeBuffer.resize(older.size());
+        comparisons = merge(older, 0, mid, static_cast<int>(older.size()) - 1, mergeBuffer, comparisons);
+    }
+    return comparisons;
+}
+
+SortedCollection::ConstIterator SortedCollection::begin() const {
+    return ConstIterator(&levels, std::vector<size_t>(levels.size(), 0));
+}
+
+SortedCollection::ConstIterator SortedCollection::end() const {
+    std::vector<size_t> positions;
+    positions.reserve(levels.size());
+    for (const auto &lvl : levels) positions.push_back(lvl.size());
+    return ConstIterator(&levels, std::move(positions));
+}
+
+SortedCollection::ConstIterator SortedCollection::lowerBound(const std::string &key) const {
+    std::vector<size_t> positions;
+    positions.reserve(levels.size());
+    for (const auto &lvl : levels) {
+        positions.push_back(std::lower_bound(lvl.begin(), lvl.end(), key) - lvl.begin());
+    }
+    return ConstIterator(&levels, std::move(positions));
+}
+
+bool SortedCollection::contains(const std::string &key) const {
+    for (const auto &lvl : levels) {
+        if (std::binary_search(lvl.begin(), lvl.end(), key)) return true;
+    }
+    return false;
+}
+
+size_t SortedCollection::size() const {
+    return totalSize;
+}
+
+bool SortedCollection::empty() const {
+    return totalSize == 0;
+}
+
+size_t SortedCollection::levelCount() const {
+    return levels.size();
+}
+
+const std::vector<std::string> &SortedCollection::level(size_t index) const {
+    return levels.at(index);
+}
+
+std::vector<std::string> SortedCollection::toVector() const {
+    std::vector<std::string> result;
+    result.reserve(totalSize);
+    for (auto it = begin(), last = end(); it != last; ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+void SortedCollection::clear() {
+    levels.clear();
+    mergeBuffer.clear();
+    totalSize = 0;
+}
@@ -0,0 +1,83 @@
+#ifndef SORTED_COLLECTION_H
+#define SORTED_COLLECTION_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Sorted multiset of strings that grows in batches without re-sorting everything.
+// Each batch is sorted with one of the engines from sort.h and becomes a new level.
+// Levels are kept ordered from largest (oldest) to smallest (newest); whenever a level
+// is not at least growthFactor times larger than the one after it, the two are merged
+// with the LCP merge from merge.cpp. This keeps O(log N) levels, and every key is
+// re-merged O(log N) times in total instead of once per batch.
+// The engines, the merge and the std::string comparisons used by the iterator and the
+// lookups all order bytes as unsigned char, so the levels and the searches agree on
+// non-ASCII keys as well.
+class SortedCollection {
+    public:
+        using SortFunction = std::function<int(std::vector<std::string>&)>;
+
+        // Forward iterator over all keys in ascending order, merging the levels on the fly.
+        class ConstIterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::string;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const std::string*;
+                using reference = const std::string&;
+
+                ConstIterator() = default;
+
+                reference operator*() const;
+                pointer operator->() const;
+                ConstIterator& operator++();
+                ConstIterator operator++(int);
+                bool operator==(const ConstIterator& other) const;
+
+            private:
+                friend class SortedCollection;
+
+                const std::vector<std::vector<std::string>>* levels = nullptr;
+                std::vector<size_t> positions;
+                size_t current = 0; // level holding the smallest remaining key, levels->size() at the end
+
+                ConstIterator(const std::vector<std::vector<std::string>>* levels, std::vector<size_t> positions);
+                void findCurrent();
+        };
+
+    private:
+        SortFunction sortFunc;
+        size_t growthFactor;
+        std::vector<std::vector<std::string>> levels;
+        std::vector<std::string> mergeBuffer;
+        size_t totalSize = 0;
+
+        int compactLevels(int comparisons);
+
+    public:
+        explicit SortedCollection(SortFunction sortFunc, size_t growthFactor = 2);
+
+        // Sorts the batch, adds it as the newest level and merges levels as needed.
+        // Returns the number of comparisons reported by the sort engine and the merges.
+        int insertBatch(std::vector<std::string> batch);
+
+        ConstIterator begin() const;
+        ConstIterator end() const;
+
+        // Iterator to the first key not less than key, or end().
+        ConstIterator lowerBound(const std::string& key) const;
+        bool contains(const std::string& key) const;
+
+        size_t size() const;
+        bool empty() const;
+        size_t levelCount() const;
+        const std::vector<std::string>& level(size_t index) const;
+
+        std::vector<std::string> toVector() const;
+        void clear();
+};
+
+#endif // SORTED_COLLECTION_H
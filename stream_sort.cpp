@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <thread>
+
+#include "stream_sort.h"
+#include "bounded_queue.h"
+
+namespace {
+    using Clock = std::chrono::high_resolution_clock;
+
+    double elapsedMs(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    }
+
+    struct Chunk {
+        std::vector<std::string> keys;
+        long long bytes = 0;
+    };
+
+    template <typename T>
+    StreamSorter::QueueStats collectQueueStats(const std::string &name, const BoundedQueue<T> &queue) {
+        return {name, queue.getCapacity(), queue.getMaxDepth(), queue.getAverageDepth(),
+                queue.getPushWaits(), queue.getPopWaits()};
+    }
+}
+
+StreamSorter::StreamSorter(SortFunction sortFunc, Options options)
+    : sortFunc(std::move(sortFunc)), options(options) {
+    if (this->options.readBlockBytes == 0) this->options.readBlockBytes = 1 << 20;
+    if (this->options.chunkKeys == 0) this->options.chunkKeys = 1 << 16;
+    if (this->options.sortThreads < 1) this->options.sortThreads = 1;
+}
+
+bool StreamSorter::run(std::istream &in, std::ostream &out) {
+    stageStats.clear();
+    queueStats.clear();
+    keysSorted = 0;
+    comparisons = 0;
+
+    BoundedQueue<std::string> rawQueue(options.queueCapacity);
+    BoundedQueue<Chunk> chunkQueue(options.queueCapacity);
+    BoundedQueue<Chunk> runQueue(options.queueCapacity);
+    BoundedQueue<std::string> outputQueue(options.queueCapacity);
+
+    StageStats readStats{"read", 0.0, 0, 0};
+    StageStats parseStats{"parse", 0.0, 0, 0};
+    StageStats sortStats{"sort", 0.0, 0, 0};
+    StageStats mergeStats{"merge", 0.0, 0, 0};
+    StageStats writeStats{"write", 0.0, 0, 0};
+    bool inputFailed = false;
+    bool outputFailed = false;
+
+    auto wallStart = Clock::now();
+
+    std::thread reader([&] {
+        while (true) {
+            auto start = Clock::now();
+            std::string block(options.readBlockBytes, '\0');
+            in.read(block.data(), static_cast<std::streamsize>(block.size()));
+            block.resize(static_cast<size_t>(in.gcount()));
+            readStats.busyMs += elapsedMs(start, Clock::now());
+
+            if (in.bad()) inputFailed = true;
+            if (block.empty()) break;
+            readStats.items++;
+            readStats.bytes += static_cast<long long>(block.size());
+            if (!rawQueue.push(std::move(block))) break;
+        }
+        rawQueue.close();
+    });
+
+    std::thread parser([&] {
+        Chunk chunk;
+        chunk.keys.reserve(options.chunkKeys);
+        std::string partial;
+        bool headerPending = options.skipCountHeader;
+
+        auto emitKey = [&](std::string key) {
+            if (headerPending) {
+                headerPending = false;
+                return;
+            }
+            chunk.bytes += static_cast<long long>(key.size()) + 1;
+            chunk.keys.push_back(std::move(key));
+            if (chunk.keys.size() >= options.chunkKeys) {
+                parseStats.items++;
+                parseStats.bytes += chunk.bytes;
+                chunkQueue.push(std::move(chunk));
+                chunk = Chunk();
+                chunk.keys.reserve(options.chunkKeys);
+            }
+        };
+
+        std::string block;
+        while (rawQueue.pop(block)) {
+            auto start = Clock::now();
+            size_t lineStart = 0;
+            size_t newline;
+            while ((newline = block.find('\n', lineStart)) != std::string::npos) {
+                if (partial.empty()) {
+                    emitKey(block.substr(lineStart, newline - lineStart));
+                } else {
+                    partial.append(block, lineStart, newline - lineStart);
+                    emitKey(std::move(partial));
+                    partial.clear();
+                }
+                lineStart = newline + 1;
+            }
+            partial.append(block, lineStart, std::string::npos);
+            parseStats.busyMs += elapsedMs(start, Clock::now());
+        }
+
+        // A last line without a trailing newline is still a key.
+        if (!partial.empty()) emitKey(std::move(partial));
+        if (!chunk.keys.empty()) {
+            parseStats.items++;
+            parseStats.bytes += chunk.bytes;
+            chunkQueue.push(std::move(chunk));
+        }
+        chunkQueue.close();
+    });
+
+    std::mutex sortStatsMutex;
+    std::atomic<int> activeSorters(options.sortThreads);
+    std::vector<std::thread> sorters;
+    for (int t = 0; t < options.sortThreads; ++t) {
+        sorters.emplace_back([&] {
+            Chunk chunk;
+            while (chunkQueue.pop(chunk)) {
+                auto start = Clock::now();
+                long long chunkComparisons = sortFunc(chunk.keys);
+                double busy = elapsedMs(start, Clock::now());
+                {
+                    std::lock_guard<std::mutex> lock(sortStatsMutex);
+                    sortStats.busyMs += busy;
+                    sortStats.items++;
+                    sortStats.bytes += chunk.bytes;
+                    comparisons += chunkComparisons;
+                }
+                runQueue.push(std::move(chunk));
+            }
+            if (--activeSorters == 0) runQueue.close();
+        });
+    }
+
+    std::thread merger([&] {
+        // Runs are collected while the upstream stages are still producing them;
+        // the k-way merge itself can only start once the last run is sorted.
+        std::vector<Chunk> runs;
+        Chunk run;
+        while (runQueue.pop(run)) {
+            runs.push_back(std::move(run));
+        }
+
+        auto start = Clock::now();
+        using Cursor = std::pair<size_t, size_t>; // (run, position)
+        auto greater = [&runs](const Cursor &a, const Cursor &b) {
+            return runs[b.first].keys[b.second] < runs[a.first].keys[a.second];
+        };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap(greater);
+        for (size_t r = 0; r < runs.size(); ++r) {
+            if (!runs[r].keys.empty()) heap.push({r, 0});
+        }
+
+        std::string block;
+        block.reserve(options.readBlockBytes + 256);
+        while (!heap.empty()) {
+            Cursor top = heap.top();
+            heap.pop();
+            block += runs[top.first].keys[top.second];
+            block += '\n';
+            mergeStats.items++;
+            if (++top.second < runs[top.first].keys.size()) heap.push(top);
+
+            if (block.size() >= options.readBlockBytes) {
+                mergeStats.bytes += static_cast<long long>(block.size());
+                mergeStats.busyMs += elapsedMs(start, Clock::now());
+                outputQueue.push(std::move(block));
+                start = Clock::now();
+                block = std::string();
+                block.reserve(options.readBlockBytes + 256);
+            }
+        }
+        if (!block.empty()) {
+            mergeStats.bytes += static_cast<long long>(block.size());
+            mergeStats.busyMs += elapsedMs(start, Clock::now());
+            outputQueue.push(std::move(block));
+        } else {
+            mergeStats.busyMs += elapsedMs(start, Clock::now());
+        }
+        outputQueue.close();
+    });
+
+    std::thread writer([&] {
+        std::string block;
+        while (outputQueue.pop(block)) {
+            auto start = Clock::now();
+            if (!outputFailed) {
+                out.write(block.data(), static_cast<std::streamsize>(block.size()));
+                if (!out) outputFailed = true;
+            }
+            writeStats.busyMs += elapsedMs(start, Clock::now());
+            writeStats.items++;
+            writeStats.bytes += static_cast<long long>(block.size());
+        }
+        auto start = Clock::now();
+        out.flush();
+        if (!out) outputFailed = true;
+        writeStats.busyMs += elapsedMs(start, Clock::now());
+    });
+
+    reader.join();
+    parser.join();
+    for (auto &sorter : sorters) sorter.join();
+    merger.join();
+    writer.join();
+
+    wallTimeMs = elapsedMs(wallStart, Clock::now());
+    keysSorted = mergeStats.items;
+
+    stageStats = {readStats, parseStats, sortStats, mergeStats, writeStats};
+    queueStats = {
+        collectQueueStats("read->parse", rawQueue),
+        collectQueueStats("parse->sort", chunkQueue),
+        collectQueueStats("sort->merge", runQueue),
+        collectQueueStats("merge->write", outputQueue),
+    };
+
+    if (inputFailed) std::cerr << "Error: Failed while reading input" << std::endl;
+    if (outputFailed) std::cerr << "Error: Failed while writing output" << std::endl;
+    return !inputFailed && !outputFailed;
+}
+
+const std::vector<StreamSorter::StageStats> &StreamSorter::getStageStats() const {
+    return stageStats;
+}
+
+const std::vector<StreamSorter::QueueStats> &StreamSorter::getQueueStats() const {
+    return queueStats;
+}
+
+long long StreamSorter::getKeysSorted() const {
+    return keysSorted;
+}
+
+void StreamSorter::printStats(std::ostream &os) const {
+    os << "\n--- Pipeline Stats ---" << std::endl;
+    os << "Keys: " << keysSorted
+       << " | Comparisons: " << comparisons
+       << " | Wall: " << std::fixed << std::setprecision(3) << wallTimeMs << " ms" << std::endl;
+    for (const auto &stage : stageStats) {
+        os << "Stage: " << std::setw(6) << std::left << stage.stageName
+           << " | Busy: " << std::setw(10) << std::fixed << std::setprecision(3) << std::right << stage.busyMs << " ms"
+           << " | Items: " << std::setw(8) << std::right << stage.items
+           << " | Bytes: " << std::setw(12) << std::right << stage.bytes << std::endl;
+    }
+    for (const auto &queue : queueStats) {
+        os << "Queue: " << std::setw(12) << std::left << queue.queueName
+           << " | Max depth: " << queue.maxDepth << "/" << queue.capacity
+           << " | Avg depth: " << std::fixed << std::setprecision(2) << queue.averageDepth
+           << " | Full waits: " << queue.pushWaits
+           << " | Empty waits: " << queue.popWaits << std::endl;
+    }
+    os << "----------------------" << std::endl;
+}
@@ -0,0 +1,65 @@
+#ifndef STREAM_SORT_H
+#define STREAM_SORT_H
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Sorts newline-separated keys from a stream as a pipeline of concurrent stages:
+//   read -> parse -> sort -> merge -> write
+// Stages are connected by bounded queues, so reading the input and writing the
+// output overlap with the CPU-bound parsing and sorting of chunks.
+// Each chunk is sorted with one of the engines from sort.h, and the sorted runs
+// are merged, so the output is the same as sorting the whole input at once.
+class StreamSorter {
+    public:
+        using SortFunction = std::function<int(std::vector<std::string>&)>;
+
+        struct Options {
+            size_t readBlockBytes = 1 << 20;   // bytes per read() from the input
+            size_t chunkKeys = 1 << 16;        // keys per sorted run
+            size_t queueCapacity = 4;          // items each queue holds before blocking
+            int sortThreads = 1;               // concurrent sort stage workers
+            bool skipCountHeader = false;      // first line is a key count (StringGenerator file format)
+        };
+
+        struct StageStats {
+            std::string stageName;
+            double busyMs;         // time spent working, excluding waits on queues
+            long long items;       // blocks/chunks/runs handled by the stage
+            long long bytes;
+        };
+
+        struct QueueStats {
+            std::string queueName;
+            size_t capacity;
+            size_t maxDepth;
+            double averageDepth;
+            long long pushWaits;
+            long long popWaits;
+        };
+
+    private:
+        SortFunction sortFunc;
+        Options options;
+
+        std::vector<StageStats> stageStats;
+        std::vector<QueueStats> queueStats;
+        double wallTimeMs = 0.0;
+        long long keysSorted = 0;
+        long long comparisons = 0;
+
+    public:
+        StreamSorter(SortFunction sortFunc, Options options);
+
+        // Returns false if the input or output stream failed.
+        bool run(std::istream& in, std::ostream& out);
+
+        const std::vector<StageStats>& getStageStats() const;
+        const std::vector<QueueStats>& getQueueStats() const;
+        long long getKeysSorted() const;
+        void printStats(std::ostream& os) const;
+};
+
+#endif // STREAM_SORT_H
@@ -0,0 +1,33 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Keys stored back to back in one buffer, as built by StringGenerator::generateArena.
+// key(i) is the i-th element of the generated array; the bytes stay in generation order,
+// so ordering the array (SORTED, REVERSE_SORTED, ...) does not move any key data.
+class StringArena {
+    public:
+        StringArena() = default;
+
+        size_t size() const { return order.size(); }
+        size_t bytes() const { return dataBytes; }
+
+        std::string_view key(size_t i) const {
+            size_t k = order[i];
+            return std::string_view(data.get() + offsets[k], offsets[k + 1] - offsets[k]);
+        }
+
+    private:
+        friend class StringGenerator;
+
+        std::unique_ptr<char[]> data;   // left uninitialized so the generating threads touch it first
+        size_t dataBytes = 0;
+        std::vector<size_t> offsets;    // key k occupies [offsets[k], offsets[k + 1])
+        std::vector<int> order;         // array position -> key index
+};
+
+#endif // STRING_ARENA_H
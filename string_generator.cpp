@@ -1,11 +1,149 @@
 #include "string_generator.h"
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <filesystem> // Для prepareTestArrays, если используется
 #include <iostream>   // Для prepareTestArrays, если используется
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    // Keys per arena block; every block has its own generator, so the output does not
+    // depend on how blocks are spread over threads.
+    const int ARENA_BLOCK_KEYS = 4096;
+
+    // Independent random streams of one arena: key lengths, key characters, everything else.
+    enum ArenaStream { LENGTH_STREAM, CHAR_STREAM, ORDER_STREAM };
+
+    std::mt19937 arenaRng(unsigned int seed, int block, ArenaStream stream) {
+        std::seed_seq seq{seed, static_cast<unsigned int>(block), static_cast<unsigned int>(stream)};
+        return std::mt19937(seq);
+    }
+
+    int resolveThreads(const StringGenerator::ArenaOptions &options) {
+        if (options.threads > 0) return options.threads;
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Parses /sys/devices/system/node/node<N>/cpulist, e.g. "0-3,8-11".
+    std::vector<int> cpusOfNumaNode(int node) {
+        std::vector<int> cpus;
+        std::ifstream inFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!std::getline(inFile, list)) return cpus;
+
+        std::stringstream ranges(list);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            if (range.empty()) continue;
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    // CPUs this process may run on (sched_getaffinity), empty if the mask cannot be read.
+    std::vector<int> allowedCpus() {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+#endif
+        return cpus;
+    }
+
+    // Returns false if the thread could not be pinned.
+    bool pinCurrentThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    // Runs work(t) for t in [0, threads). With FIRST_TOUCH_LAYOUT each worker is pinned first,
+    // to the usable CPUs of options.numaNode or else to the t-th CPU in the affinity mask, so
+    // the pages it writes are placed near it.
+    void runOnThreads(int threads, const StringGenerator::ArenaOptions &options, const std::function<void(int)> &work) {
+        bool pin = options.layout == StringGenerator::FIRST_TOUCH_LAYOUT;
+        std::vector<int> cpus;
+        if (pin) {
+            if (options.pinningResolved) {
+                cpus = options.pinCpus;
+            } else {
+                StringGenerator::ArenaOptions resolved = options;
+                StringGenerator::resolvePinning(resolved);
+                cpus = resolved.pinCpus;
+            }
+            pin = !cpus.empty();
+        }
+
+        std::atomic<int> pinFailures(0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                if (pin) {
+                    std::vector<int> target = options.numaNode >= 0 ? cpus : std::vector<int>{cpus[t % cpus.size()]};
+                    if (!pinCurrentThread(target)) pinFailures++;
+                }
+                work(t);
+            });
+        }
+        for (auto &worker : workers) worker.join();
+
+        // Reported once per process, not once per generated array.
+        static std::atomic<bool> pinFailureReported(false);
+        if (pinFailures > 0 && !pinFailureReported.exchange(true)) {
+            std::cerr << "Warning: " << pinFailures << " of " << threads
+                    << " threads could not be pinned, first-touch placement is not guaranteed" << std::endl;
+        }
+    }
+}
+
+bool StringGenerator::resolvePinning(ArenaOptions &options) {
+    options.pinningResolved = true;
+    options.pinCpus.clear();
+    std::vector<int> cpus = allowedCpus();
+    if (cpus.empty()) {
+        std::cerr << "Warning: CPU affinity mask not available, threads are not pinned" << std::endl;
+        return false;
+    }
+    if (options.numaNode < 0) {
+        options.pinCpus = cpus;
+        return true;
+    }
+    for (int cpu : cpusOfNumaNode(options.numaNode)) {
+        if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) options.pinCpus.push_back(cpu);
+    }
+    if (options.pinCpus.empty()) {
+        std::cerr << "Warning: NUMA node " << options.numaNode
+                << " not found or none of its CPUs are allowed, threads are not pinned" << std::endl;
+        return false;
+    }
+    return true;
+}
 
 StringGenerator::StringGenerator(unsigned int seed) {
     allowedChars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!@#%:;^&*()-.";
+    for (int c = 0; c < 256; ++c) {
+        if (c != '\n') byteChars.push_back(static_cast<char>(c));
+    }
     rng = std::mt19937(seed);
     charDist = std::uniform_int_distribution<int>(0, allowedChars.size() - 1);
     lengthDist = std::uniform_int_distribution<int>(10, 200);
@@ -102,6 +240,147 @@ std::vector<std::string> StringGenerator::generateCommonPrefixArray(int size, in
     return generateStringArray(COMMON_PREFIX, size, prefixLength);
 }
 
+std::vector<std::string> StringGenerator::generateByteStringArray(int size, int maxLength) {
+    std::uniform_int_distribution<int> byteDist(0, byteChars.size() - 1);
+    std::uniform_int_distribution<int> shortLengthDist(1, std::max(1, maxLength));
+    std::vector<std::string> result;
+    result.reserve(size);
+    for (int i = 0; i < size; i++) {
+        int length = shortLengthDist(rng);
+        std::string key;
+        key.reserve(length);
+        for (int j = 0; j < length; j++) {
+            key.push_back(byteChars[byteDist(rng)]);
+        }
+        result.push_back(key);
+    }
+    return result;
+}
+
+StringArena StringGenerator::generateArena(ArrayType type, int size, const ArenaOptions &options, int prefixLengthForCommon, double almostSortedSwapPercentage) {
+    StringArena arena;
+    if (size <= 0) return arena;
+
+    int threads = resolveThreads(options);
+    int blocks = (size + ARENA_BLOCK_KEYS - 1) / ARENA_BLOCK_KEYS;
+
+    std::string prefix;
+    if (type == COMMON_PREFIX) {
+        if (prefixLengthForCommon <= 0 || prefixLengthForCommon > 200) prefixLengthForCommon = 5;
+        std::mt19937 prefixRng = arenaRng(options.seed, 0, ORDER_STREAM);
+        for (int i = 0; i < prefixLengthForCommon; i++) {
+            prefix.push_back(allowedChars[charDist(prefixRng)]);
+        }
+    }
+
+    // Pass 1: key lengths, stored in offsets[k + 1] and then turned into offsets.
+    arena.offsets.assign(size + 1, 0);
+    runOnThreads(threads, options, [&](int t) {
+        std::uniform_int_distribution<int> lengths = lengthDist;
+        for (int block = t; block < blocks; block += threads) {
+            std::mt19937 rng = arenaRng(options.seed, block, LENGTH_STREAM);
+            int end = std::min(size, (block + 1) * ARENA_BLOCK_KEYS);
+            for (int k = block * ARENA_BLOCK_KEYS; k < end; k++) {
+                int length = lengths(rng);
+                if (type == COMMON_PREFIX) {
+                    int prefixLength = static_cast<int>(prefix.size());
+                    int suffixLength = std::max(length - prefixLength, 0);
+                    if (prefixLength + suffixLength < 10) suffixLength = std::max(10 - prefixLength, 0);
+                    length = prefixLength + suffixLength;
+                }
+                arena.offsets[k + 1] = length;
+            }
+        }
+    });
+    std::partial_sum(arena.offsets.begin(), arena.offsets.end(), arena.offsets.begin());
+    arena.dataBytes = arena.offsets.back();
+    arena.data.reset(new char[arena.dataBytes]);
+
+    // Pass 2: key characters, written by the thread that owns the block.
+    runOnThreads(threads, options, [&](int t) {
+        std::uniform_int_distribution<int> chars = charDist;
+        for (int block = t; block < blocks; block += threads) {
+            std::mt19937 rng = arenaRng(options.seed, block, CHAR_STREAM);
+            int end = std::min(size, (block + 1) * ARENA_BLOCK_KEYS);
+            for (int k = block * ARENA_BLOCK_KEYS; k < end; k++) {
+                char *out = arena.data.get() + arena.offsets[k];
+                char *last = arena.data.get() + arena.offsets[k + 1];
+                out = std::copy(prefix.begin(), prefix.end(), out);
+                while (out < last) *out++ = allowedChars[chars(rng)];
+            }
+        }
+    });
+
+    arena.order.resize(size);
+    std::iota(arena.order.begin(), arena.order.end(), 0);
+    auto keyOf = [&arena](int k) {
+        return std::string_view(arena.data.get() + arena.offsets[k], arena.offsets[k + 1] - arena.offsets[k]);
+    };
+    switch (type) {
+        case RANDOM:
+        case COMMON_PREFIX:
+            break;
+        case SORTED:
+        case ALMOST_SORTED:
+            std::sort(arena.order.begin(), arena.order.end(), [&](int a, int b) { return keyOf(a) < keyOf(b); });
+            if (type == ALMOST_SORTED && size > 1) {
+                std::mt19937 rng = arenaRng(options.seed, 1, ORDER_STREAM);
+                int swaps = std::max(1, static_cast<int>(size * almostSortedSwapPercentage));
+                std::uniform_int_distribution<int> indexDist(0, size - 1);
+                for (int i = 0; i < swaps; ++i) {
+                    int idx1 = indexDist(rng);
+                    int idx2 = indexDist(rng);
+                    std::swap(arena.order[idx1], arena.order[idx2]);
+                }
+            }
+            break;
+        case REVERSE_SORTED:
+            std::sort(arena.order.begin(), arena.order.end(), [&](int a, int b) { return keyOf(b) < keyOf(a); });
+            break;
+    }
+    return arena;
+}
+
+std::vector<std::string> StringGenerator::materialize(const StringArena &arena, const ArenaOptions &options) {
+    int size = static_cast<int>(arena.size());
+    std::vector<std::string> result(size);
+
+    switch (options.layout) {
+        case SEQUENTIAL_LAYOUT:
+            for (int i = 0; i < size; i++) {
+                result[i].assign(arena.key(i));
+            }
+            break;
+        case SHUFFLED_LAYOUT: {
+            std::vector<int> allocationOrder(size);
+            std::iota(allocationOrder.begin(), allocationOrder.end(), 0);
+            std::mt19937 rng = arenaRng(options.seed, 2, ORDER_STREAM);
+            std::shuffle(allocationOrder.begin(), allocationOrder.end(), rng);
+            for (int i : allocationOrder) {
+                result[i].assign(arena.key(i));
+            }
+            break;
+        }
+        case FIRST_TOUCH_LAYOUT: {
+            int threads = std::min(resolveThreads(options), std::max(size, 1));
+            runOnThreads(threads, options, [&](int t) {
+                int begin = static_cast<int>(static_cast<long long>(size) * t / threads);
+                int end = static_cast<int>(static_cast<long long>(size) * (t + 1) / threads);
+                for (int i = begin; i < end; i++) {
+                    result[i].assign(arena.key(i));
+                }
+            });
+            break;
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> StringGenerator::generateStringArray(ArrayType type, int size, const ArenaOptions &options, int prefixLengthForCommon, double almostSortedSwapPercentage) {
+    StringArena arena = generateArena(type, size, options, prefixLengthForCommon, almostSortedSwapPercentage);
+    return materialize(arena, options);
+}
+
 void StringGenerator::saveArrayToFile(const std::vector<std::string> &arr, const std::string &filename) {
     std::ofstream outFile(filename);
     if (!outFile.is_open()) {
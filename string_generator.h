@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <random>
+#include "string_arena.h"
 
 class StringGenerator {
 public:
@@ -15,8 +16,25 @@ public:
         COMMON_PREFIX
     };
 
+    // Order in which the std::string buffers of a materialized array are allocated.
+    enum MemoryLayout {
+        SEQUENTIAL_LAYOUT,  // in array order by one thread, so neighbours are adjacent in memory
+        SHUFFLED_LAYOUT,    // in a random order, so memory order is unrelated to array/key order
+        FIRST_TOUCH_LAYOUT  // each pinned thread allocates and first touches its slice of the array
+    };
+
+    struct ArenaOptions {
+        MemoryLayout layout = SEQUENTIAL_LAYOUT;
+        int threads = 0;            // 0 uses std::thread::hardware_concurrency()
+        int numaNode = -1;          // FIRST_TOUCH_LAYOUT: pin threads to this node's allowed CPUs, -1 pins thread t to the t-th allowed CPU
+        unsigned int seed = 1;      // the generated data depends only on the seed, not on the thread count
+        bool pinningResolved = false;   // set by resolvePinning; otherwise every pinned call resolves (and warns) again
+        std::vector<int> pinCpus;       // CPUs chosen by resolvePinning, empty if threads cannot be pinned
+    };
+
 private:
     std::string allowedChars;
+    std::string byteChars;
     std::mt19937 rng;
     std::uniform_int_distribution<int> charDist;
     std::uniform_int_distribution<int> lengthDist;
@@ -40,6 +58,28 @@ public:
 
     std::vector<std::string> generateCommonPrefixArray(int size, int prefixLength);
 
+    // Short keys over every byte value except '\n', most of them >= 0x80 and some '\0', so the
+    // result depends on bytes being compared as unsigned (the order of std::string and
+    // LC_ALL=C sort) and on a '\0' byte not being taken for the end of the key.
+    std::vector<std::string> generateByteStringArray(int size, int maxLength = 16);
+
+    // Builds the keys in parallel into one contiguous arena. Keys are generated in fixed-size
+    // blocks, each with its own seed derived from options.seed.
+    StringArena generateArena(ArrayType type, int size, const ArenaOptions& options, int prefixLengthForCommon = 5, double almostSortedSwapPercentage = 0.05);
+
+    // Picks the CPUs FIRST_TOUCH_LAYOUT threads are pinned to: the allowed CPUs of the process
+    // (sched_getaffinity), restricted to options.numaNode if it is set. Warns and leaves
+    // options.pinCpus empty if that set is empty. Call it once before generating many arrays
+    // with the same options; returns false if threads will not be pinned.
+    static bool resolvePinning(ArenaOptions& options);
+
+    // Copies the arena into std::strings, allocating them in the order given by options.layout.
+    std::vector<std::string> materialize(const StringArena& arena, const ArenaOptions& options);
+
+    // generateArena followed by materialize: a parallel, seeded replacement for the overload
+    // above, used for the large inputs of the digit width and distributed benchmarks.
+    std::vector<std::string> generateStringArray(ArrayType type, int size, const ArenaOptions& options, int prefixLengthForCommon = 5, double almostSortedSwapPercentage = 0.05);
+
     void saveArrayToFile(const std::vector<std::string>& arr, const std::string& filename);
 
     std::vector<std::string> loadArrayFromFile(const std::string& filename);
@@ -3,8 +3,14 @@
 #include <algorithm>
 #include <iomanip>
 #include <numeric>
+#include <filesystem>
+#include <sstream>
 
 #include "string_sort_tester.h"
+#include "sorted_collection.h"
+#include "radix_pass.h"
+#include "distributed_sort.h"
+#include "stream_sort.h"
 #include "sort.h"
 
 StringSortTester::StringSortTester() : generator(std::random_device{}()) {
@@ -39,6 +45,27 @@ bool StringSortTester::verifySorted(const std::vector<std::string> &original,
     return sorted_arr == correctly_sorted_original;
 }
 
+bool StringSortTester::verifyCollection(SortFunction sortFunc, const std::vector<std::vector<std::string>> &batches,
+                                        const std::vector<std::string> &probes) {
+    SortedCollection collection(sortFunc);
+    std::vector<std::string> all;
+    for (const auto &batch : batches) {
+        collection.insertBatch(batch);
+        all.insert(all.end(), batch.begin(), batch.end());
+    }
+    std::sort(all.begin(), all.end());
+    if (collection.toVector() != all) return false;
+
+    for (const auto &probe : probes) {
+        auto expected = std::lower_bound(all.begin(), all.end(), probe);
+        auto it = collection.lowerBound(probe);
+        if ((it == collection.end()) != (expected == all.end())) return false;
+        if (it != collection.end() && *it != *expected) return false;
+        if (collection.contains(probe) != std::binary_search(all.begin(), all.end(), probe)) return false;
+    }
+    return true;
+}
+
 void StringSortTester::runExperiments(const std::vector<int> &dataSizes, int numRunsPerTest) {
     results.clear();
 
@@ -131,3 +158,358 @@ void StringSortTester::printResultsSummary() const {
     }
     std::cout << "-----------------------" << std::endl;
 }
+
+
+void StringSortTester::runDigitWidthExperiment(int size, int numRuns) {
+    std::cout << "Digit width experiment: Random, size " << size << std::endl;
+
+    std::vector<std::pair<std::string, SortFunction>> radixEngines = {
+        {"Radix Sort", stringRadixSort},
+        {"Radix+Quick Sort", stringRadixSortWithQuickSwitch},
+    };
+    int previousWidth = getRadixMaxDigitWidth();
+
+    for (const auto &algoPair : radixEngines) {
+        for (int width = 1; width <= 2; ++width) {
+            setRadixMaxDigitWidth(width);
+            std::cout << "  " << std::setw(18) << std::left << algoPair.first
+                    << " max digit: " << width * 8 << "-bit..." << std::flush;
+
+            double totalTimeMs = 0.0;
+            RadixPassStats totalStats = {0, 0, 0};
+            bool allRunsVerified = true;
+            for (int run = 0; run < numRuns; ++run) {
+                // Seeded by the run, so both digit widths sort the same arrays.
+                StringGenerator::ArenaOptions arenaOptions;
+                arenaOptions.seed = static_cast<unsigned int>(run) + 1;
+                std::vector<std::string> currentArray = generator.generateStringArray(StringGenerator::RANDOM, size, arenaOptions);
+                std::vector<std::string> originalForVerify = currentArray;
+
+                resetRadixPassStats();
+                auto startTime = std::chrono::high_resolution_clock::now();
+                algoPair.second(currentArray);
+                auto endTime = std::chrono::high_resolution_clock::now();
+                RadixPassStats stats = getRadixPassStats();
+
+                totalTimeMs += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+                totalStats.oneByteLevels += stats.oneByteLevels;
+                totalStats.twoByteLevels += stats.twoByteLevels;
+                totalStats.keysDistributed += stats.keysDistributed;
+
+                if (!verifySorted(originalForVerify, currentArray)) {
+                    allRunsVerified = false;
+                }
+            }
+
+            double passesPerKey = static_cast<double>(totalStats.keysDistributed) / (static_cast<double>(size) * numRuns);
+            std::cout << " Avg Time: " << std::fixed << std::setprecision(3) << totalTimeMs / numRuns << "ms"
+                    << ", Passes/key: " << std::setprecision(2) << passesPerKey
+                    << ", 8-bit passes: " << totalStats.oneByteLevels / numRuns
+                    << ", 16-bit passes: " << totalStats.twoByteLevels / numRuns
+                    << (allRunsVerified ? "" : " (VERIFICATION FAILED!)") << std::endl;
+        }
+    }
+
+    setRadixMaxDigitWidth(previousWidth);
+    std::cout << "==========================================" << std::endl << std::endl;
+}
+
+void StringSortTester::runLayoutExperiments(int size, int numRuns, int threads, int numaNode) {
+    results.clear();
+
+    std::vector<std::pair<std::string, StringGenerator::MemoryLayout>> layouts = {
+        {"sequential", StringGenerator::SEQUENTIAL_LAYOUT},
+        {"shuffled", StringGenerator::SHUFFLED_LAYOUT},
+        {"first-touch", StringGenerator::FIRST_TOUCH_LAYOUT},
+    };
+
+    // The first-touch CPUs are resolved once, so a missing node is reported only once.
+    StringGenerator::ArenaOptions baseOptions;
+    baseOptions.threads = threads;
+    baseOptions.numaNode = numaNode;
+    StringGenerator::resolvePinning(baseOptions);
+
+    std::cout << "Layout experiment: size " << size << std::endl;
+    for (const auto &dataTypePair : dataTypesToTest) {
+        StringGenerator::ArenaOptions options = baseOptions;
+        StringArena arena = generator.generateArena(dataTypePair.second, size, options);
+
+        for (const auto &layoutPair : layouts) {
+            options.layout = layoutPair.second;
+            std::string typeName = dataTypePair.first + " [" + layoutPair.first + "]";
+            std::cout << "  Data Type: " << typeName << std::endl;
+
+            for (const auto &algoPair : algorithmsToTest) {
+                std::cout << "    Algorithm: " << algoPair.first << "..." << std::flush;
+
+                std::vector<double> runTimesMs;
+                std::vector<long long> runComparisons;
+                bool allRunsVerified = true;
+
+                for (int run = 0; run < numRuns; ++run) {
+                    std::vector<std::string> currentArray = generator.materialize(arena, options);
+                    std::vector<std::string> originalForVerify = currentArray;
+
+                    auto startTime = std::chrono::high_resolution_clock::now();
+                    long long comparisons = algoPair.second(currentArray);
+                    auto endTime = std::chrono::high_resolution_clock::now();
+
+                    runTimesMs.push_back(
+                        std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0);
+                    runComparisons.push_back(comparisons);
+
+                    if (!verifySorted(originalForVerify, currentArray)) {
+                        allRunsVerified = false;
+                    }
+                }
+
+                double avgTimeMs = std::accumulate(runTimesMs.begin(), runTimesMs.end(), 0.0) / runTimesMs.size();
+                long long avgComparisons = std::accumulate(runComparisons.begin(), runComparisons.end(), 0LL) /
+                                           static_cast<long long>(runComparisons.size());
+
+                results.push_back({algoPair.first, typeName, size, avgTimeMs, avgComparisons, allRunsVerified});
+                std::cout << " Avg Time: " << std::fixed << std::setprecision(3) << avgTimeMs << "ms"
+                        << (allRunsVerified ? "" : " (VERIFICATION FAILED!)") << std::endl;
+            }
+        }
+        std::cout << "  -------------------------------------" << std::endl;
+    }
+    std::cout << "==========================================" << std::endl << std::endl;
+}
+
+void StringSortTester::runDistributedExperiments(int totalKeys, const std::vector<int> &workerCounts) {
+    std::cout << "Distributed sort: " << totalKeys << " Random keys" << std::endl;
+
+    std::vector<std::string> keys = generator.generateStringArray(StringGenerator::RANDOM, totalKeys, StringGenerator::ArenaOptions());
+    std::string baseDir = (std::filesystem::temp_directory_path() / "a1_distributed").string();
+    DistributedSorter sorter;
+    std::vector<std::pair<int, double>> wallTimes;
+
+    for (int workers : workerCounts) {
+        if (workers <= 0) continue;
+        std::filesystem::remove_all(baseDir);
+        std::filesystem::create_directories(baseDir + "/shards");
+
+        std::vector<std::string> shardFiles;
+        for (int w = 0; w < workers; ++w) {
+            size_t begin = keys.size() * w / workers;
+            size_t end = keys.size() * (w + 1) / workers;
+            std::vector<std::string> shard(keys.begin() + static_cast<long>(begin), keys.begin() + static_cast<long>(end));
+            shardFiles.push_back(baseDir + "/shards/shard_" + std::to_string(w) + ".txt");
+            generator.saveArrayToFile(shard, shardFiles.back());
+        }
+
+        DistributedSorter::RunResult result = sorter.run(shardFiles, baseDir + "/out");
+
+        std::vector<std::string> output;
+        if (result.ok) {
+            for (const auto &file : result.outputFiles) {
+                std::vector<std::string> part = generator.loadArrayFromFile(file);
+                std::move(part.begin(), part.end(), std::back_inserter(output));
+            }
+        }
+        bool verified = result.ok && verifySorted(keys, output);
+
+        DistributedSorter::printRunSummary(result);
+        if (!verified) std::cout << "VERIFICATION FAILED!" << std::endl;
+        wallTimes.push_back({workers, result.wallTimeMs});
+    }
+    std::filesystem::remove_all(baseDir);
+
+    std::cout << "\n--- Distributed Scaling ---" << std::endl;
+    for (const auto &entry : wallTimes) {
+        double speedup = entry.second > 0 ? wallTimes.front().second / entry.second : 0.0;
+        std::cout << "Workers: " << std::setw(2) << std::right << entry.first
+                << " | Wall: " << std::setw(10) << std::fixed << std::setprecision(3) << entry.second << " ms"
+                << " | Speedup: " << std::setprecision(2) << speedup << "x" << std::endl;
+    }
+    std::cout << "---------------------------" << std::endl;
+}
+
+bool StringSortTester::runStreamSortCheck(int size, size_t chunkKeys) {
+    std::cout << "Stream sort check: " << size << " non-ASCII keys, " << chunkKeys << " keys per chunk" << std::endl;
+
+    std::vector<std::string> keys = generator.generateByteStringArray(size);
+    std::string input;
+    for (const std::string &key : keys) {
+        input += key;
+        input += '\n';
+    }
+
+    std::vector<std::string> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    bool allPassed = true;
+    for (const auto &algoPair : algorithmsToTest) {
+        for (int threads : {1, 4}) {
+            std::cout << "  " << std::setw(18) << std::left << algoPair.first
+                    << " threads: " << threads << "..." << std::flush;
+
+            StreamSorter::Options options;
+            options.chunkKeys = chunkKeys;
+            options.sortThreads = threads;
+            StreamSorter sorter(algoPair.second, options);
+
+            std::istringstream in(input);
+            std::ostringstream out;
+            bool ok = sorter.run(in, out);
+
+            std::vector<std::string> sorted;
+            std::istringstream lines(out.str());
+            std::string line;
+            while (std::getline(lines, line)) {
+                sorted.push_back(line);
+            }
+
+            ok = ok && sorted == expected;
+            allPassed = allPassed && ok;
+            std::cout << (ok ? " OK" : " (VERIFICATION FAILED!)") << std::endl;
+        }
+    }
+
+    std::cout << "==========================================" << std::endl << std::endl;
+    return allPassed;
+}
+
+void StringSortTester::runIncrementalExperiments(int batchSize, int numBatches, int numLookups) {
+    incrementalResults.clear();
+    if (batchSize <= 0 || numBatches <= 0) return;
+
+    std::cout << "Incremental ingest: " << numBatches << " batches of " << batchSize << " keys" << std::endl;
+
+    std::vector<std::vector<std::string>> batches;
+    batches.reserve(numBatches);
+    for (int b = 0; b < numBatches; ++b) {
+        batches.push_back(generator.generateStringArray(StringGenerator::RANDOM, batchSize));
+    }
+
+    // Half of the probes hit existing keys, half are fresh strings.
+    std::vector<std::string> probes = generator.generateStringArray(StringGenerator::RANDOM, numLookups / 2);
+    std::mt19937 probeRng(12345);
+    std::uniform_int_distribution<int> batchDist(0, numBatches - 1);
+    std::uniform_int_distribution<int> keyDist(0, batchSize - 1);
+    while (static_cast<int>(probes.size()) < numLookups) {
+        probes.push_back(batches[batchDist(probeRng)][keyDist(probeRng)]);
+    }
+    std::shuffle(probes.begin(), probes.end(), probeRng);
+
+    // Non-ASCII keys, only used to verify the byte order of the collection.
+    int byteBatchCount = std::min(numBatches, 16);
+    std::vector<std::vector<std::string>> byteBatches;
+    for (int b = 0; b < byteBatchCount; ++b) {
+        byteBatches.push_back(generator.generateByteStringArray(batchSize, 4));
+    }
+    std::vector<std::string> byteProbes = generator.generateByteStringArray(std::min(numLookups, 1000), 4);
+    byteProbes.push_back(byteBatches[0][0]);
+
+    double totalKeys = static_cast<double>(batchSize) * numBatches;
+
+    for (const auto &algoPair : algorithmsToTest) {
+        const std::string &algoName = algoPair.first;
+        SortFunction sortFunc = algoPair.second;
+
+        std::cout << "  Algorithm: " << algoName << "..." << std::flush;
+
+        // Baseline: append the batch and re-sort everything.
+        std::vector<std::string> all;
+        double fullIngestMs = 0.0;
+        for (const auto &batch : batches) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            all.insert(all.end(), batch.begin(), batch.end());
+            sortFunc(all);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            fullIngestMs += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+        }
+
+        size_t fullChecksum = 0;
+        auto lookupStart = std::chrono::high_resolution_clock::now();
+        for (const auto &probe : probes) {
+            auto it = std::lower_bound(all.begin(), all.end(), probe);
+            if (it != all.end()) fullChecksum += it->size();
+        }
+        auto lookupEnd = std::chrono::high_resolution_clock::now();
+        double fullLookupNs = probes.empty() ? 0.0 :
+            std::chrono::duration_cast<std::chrono::nanoseconds>(lookupEnd - lookupStart).count() /
+            static_cast<double>(probes.size());
+
+        // Incremental: sort only the new batch and merge levels.
+        SortedCollection collection(sortFunc);
+        double incrementalIngestMs = 0.0;
+        for (const auto &batch : batches) {
+            std::vector<std::string> copy = batch;
+            auto startTime = std::chrono::high_resolution_clock::now();
+            collection.insertBatch(std::move(copy));
+            auto endTime = std::chrono::high_resolution_clock::now();
+            incrementalIngestMs += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+        }
+
+        size_t incrementalChecksum = 0;
+        lookupStart = std::chrono::high_resolution_clock::now();
+        for (const auto &probe : probes) {
+            auto it = collection.lowerBound(probe);
+            if (it != collection.end()) incrementalChecksum += it->size();
+        }
+        lookupEnd = std::chrono::high_resolution_clock::now();
+        double incrementalLookupNs = probes.empty() ? 0.0 :
+            std::chrono::duration_cast<std::chrono::nanoseconds>(lookupEnd - lookupStart).count() /
+            static_cast<double>(probes.size());
+
+        bool fullVerified = std::is_sorted(all.begin(), all.end());
+        bool incrementalVerified = fullVerified && collection.toVector() == all && incrementalChecksum == fullChecksum &&
+                                   verifyCollection(sortFunc, byteBatches, byteProbes);
+
+        incrementalResults.push_back({algoName, "Full Re-sort", batchSize, numBatches, fullIngestMs,
+                                      fullIngestMs > 0 ? totalKeys / (fullIngestMs / 1000.0) : 0.0,
+                                      fullLookupNs, 1, fullVerified});
+        incrementalResults.push_back({algoName, "Incremental", batchSize, numBatches, incrementalIngestMs,
+                                      incrementalIngestMs > 0 ? totalKeys / (incrementalIngestMs / 1000.0) : 0.0,
+                                      incrementalLookupNs, collection.levelCount(), incrementalVerified});
+
+        std::cout << " Full: " << std::fixed << std::setprecision(3) << fullIngestMs << "ms"
+                << ", Incremental: " << incrementalIngestMs << "ms"
+                << ((fullVerified && incrementalVerified) ? "" : " (VERIFICATION FAILED!)") << std::endl;
+    }
+    std::cout << "==========================================" << std::endl << std::endl;
+}
+
+const std::vector<StringSortTester::IncrementalResult> &StringSortTester::getIncrementalResults() const {
+    return incrementalResults;
+}
+
+void StringSortTester::saveIncrementalResultsToCsv(const std::string &filename) const {
+    std::ofstream outFile(filename);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Could not open file for writing: " << filename << std::endl;
+        return;
+    }
+
+    outFile << "Algorithm,Mode,BatchSize,Batches,IngestTime_ms,KeysPerSecond,Lookup_ns,Levels,Verified\n";
+    for (const auto &res : incrementalResults) {
+        outFile << res.algorithmName << ","
+                << res.modeName << ","
+                << res.batchSize << ","
+                << res.numBatches << ","
+                << std::fixed << std::setprecision(6) << res.ingestTimeMs << ","
+                << std::setprecision(1) << res.keysPerSecond << ","
+                << std::setprecision(1) << res.lookupNs << ","
+                << res.levels << ","
+                << (res.verified ? "true" : "false") << "\n";
+    }
+    outFile.close();
+    std::cout << "Results saved to " << filename << std::endl;
+}
+
+void StringSortTester::printIncrementalResultsSummary() const {
+    std::cout << "\n--- Incremental Results Summary ---" << std::endl;
+    for (const auto &res : incrementalResults) {
+        std::cout << "Algo: " << std::setw(18) << std::left << res.algorithmName
+                << " | Mode: " << std::setw(12) << std::left << res.modeName
+                << " | Ingest: " << std::setw(10) << std::fixed << std::setprecision(3) << std::right << res.ingestTimeMs
+                << " ms"
+                << " | Keys/s: " << std::setw(12) << std::setprecision(0) << std::right << res.keysPerSecond
+                << " | Lookup: " << std::setw(8) << std::setprecision(1) << std::right << res.lookupNs << " ns"
+                << " | Levels: " << std::setw(3) << std::right << res.levels
+                << " | Verified: " << (res.verified ? "Yes" : "NO!") << std::endl;
+    }
+    std::cout << "-----------------------------------" << std::endl;
+}
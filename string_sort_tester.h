@@ -20,14 +20,31 @@ class StringSortTester {
             bool verified;
         };
 
+        struct IncrementalResult {
+            std::string algorithmName;
+            std::string modeName;       // "Incremental" or "Full Re-sort"
+            int batchSize;
+            int numBatches;
+            double ingestTimeMs;        // total time to make the set sorted after every batch
+            double keysPerSecond;
+            double lookupNs;            // average lower_bound latency on the final set
+            size_t levels;
+            bool verified;
+        };
+
     private:
         StringGenerator generator;
         std::vector<ExperimentResult> results;
+        std::vector<IncrementalResult> incrementalResults;
 
         std::vector<std::pair<std::string, SortFunction>> algorithmsToTest;
         std::vector<std::pair<std::string, StringGenerator::ArrayType>> dataTypesToTest;
 
         bool verifySorted(const std::vector<std::string>& original, const std::vector<std::string>& sorted);
+        // Ingests batches into a SortedCollection and checks the iteration order and lowerBound on
+        // every probe against std::sort and std::lower_bound.
+        bool verifyCollection(SortFunction sortFunc, const std::vector<std::vector<std::string>>& batches,
+                              const std::vector<std::string>& probes);
 
 
     public:
@@ -41,6 +58,32 @@ class StringSortTester {
         const std::vector<ExperimentResult>& getResults() const;
         void saveResultsToCsv(const std::string& filename) const;
         void printResultsSummary() const;
+
+        // Runs the radix engines on RANDOM data with one- and two-character digits and
+        // prints how many distribution passes each string went through. Run r sorts the
+        // arena generated with seed r + 1, so both widths see the same arrays.
+        void runDigitWidthExperiment(int size, int numRuns = 3);
+
+        // Splits totalKeys RANDOM keys into one shard per worker and sorts them with DistributedSorter,
+        // printing per-phase times and the speedup over the first worker count.
+        void runDistributedExperiments(int totalKeys, const std::vector<int>& workerCounts);
+
+        // Runs every algorithm and data type on arrays materialized from the same arena with each
+        // memory layout, so that only the placement of the key buffers differs between runs.
+        // numaNode is passed to StringGenerator::ArenaOptions for the first-touch layout.
+        void runLayoutExperiments(int size, int numRuns = 3, int threads = 0, int numaNode = -1);
+
+        // Sorts non-ASCII keys (StringGenerator::generateByteStringArray) through StreamSorter in
+        // chunks of chunkKeys with every algorithm, on one and on several sort threads, so that
+        // each engine and the run merge have to agree on byte order. Returns false on any mismatch.
+        bool runStreamSortCheck(int size, size_t chunkKeys = 1000);
+
+        // Compares SortedCollection against appending each batch and re-sorting the whole array.
+        // Each algorithm is also verified on non-ASCII batches (StringGenerator::generateByteStringArray).
+        void runIncrementalExperiments(int batchSize, int numBatches, int numLookups = 10000);
+        const std::vector<IncrementalResult>& getIncrementalResults() const;
+        void saveIncrementalResultsToCsv(const std::string& filename) const;
+        void printIncrementalResultsSummary() const;
 };
 
 #endif // STRING_SORT_TESTER_H
\ No newline at end of file